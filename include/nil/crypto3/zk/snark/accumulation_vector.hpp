@@ -27,8 +27,15 @@
 #ifndef CRYPTO3_ZK_SNARK_ACCUMULATION_VECTOR_HPP
 #define CRYPTO3_ZK_SNARK_ACCUMULATION_VECTOR_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
 #include <iostream>
 #include <iterator>
+#include <vector>
+
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
 
 #include <nil/crypto3/zk/snark/sparse_vector.hpp>
 
@@ -98,6 +105,129 @@ namespace nil {
                         underlying_value_type new_first = first + acc_result.first;
                         return accumulation_vector<Type>(std::move(new_first), std::move(acc_result.second));
                     }
+
+                    /**
+                     * The accumulation value after accumulating [begin, end) from index 0, as the first member
+                     * of accumulate_chunk(begin, end, 0), without building the sparse vector of the
+                     * non-accumulated values: one multiexp per run of consecutive indices, reading the bases
+                     * in place.
+                     */
+                    template<typename InputIterator>
+                    underlying_value_type accumulate(InputIterator begin, InputIterator end) const {
+#ifdef MULTICORE
+                        const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                             // var or call omp_set_num_threads()
+#else
+                        const std::size_t chunks = 1;
+#endif
+
+                        const std::size_t input_size = std::distance(begin, end);
+                        underlying_value_type result = first;
+                        std::size_t block_begin = 0;
+                        while (block_begin < rest.indices.size() && rest.indices[block_begin] < input_size) {
+                            std::size_t block_end = block_begin + 1;
+                            while (block_end < rest.indices.size() && rest.indices[block_end] < input_size &&
+                                   rest.indices[block_end] == rest.indices[block_end - 1] + 1) {
+                                ++block_end;
+                            }
+                            result = result + algebra::multiexp<algebra::policies::multiexp_method_bos_coster>(
+                                                  rest.values.begin() + block_begin, rest.values.begin() + block_end,
+                                                  begin + rest.indices[block_begin],
+                                                  begin + rest.indices[block_end - 1] + 1, chunks);
+                            block_begin = block_end;
+                        }
+                        return result;
+                    }
+
+                    /**
+                     * Same as accumulate(), by one scalar multiplication per non-zero input instead of a
+                     * multiexp: slower on long inputs, but it allocates nothing.
+                     */
+                    template<typename InputIterator>
+                    underlying_value_type accumulate_in_place(InputIterator begin, InputIterator end) const {
+                        const std::size_t input_size = std::distance(begin, end);
+                        underlying_value_type result = first;
+                        for (std::size_t i = 0; i < rest.indices.size() && rest.indices[i] < input_size; ++i) {
+                            const auto &scalar = *(begin + rest.indices[i]);
+                            if (!scalar.is_zero()) {
+                                result = result + scalar * rest.values[i];
+                            }
+                        }
+                        return result;
+                    }
+                };
+
+                /**
+                 * An accumulation vector whose sparse vector is replaced by one window table per base.
+                 * It suits bases that are accumulated against many different inputs, e.g. the gamma_ABC_g1
+                 * of a verification key used for many verifications: the method "accumulate" then does one
+                 * windowed exponentiation per non-zero input and allocates nothing.
+                 *
+                 * Each table holds table_size(scalar_size, window) points, which doubles with every bit of
+                 * window; callers bound the window by the memory they can spend on the tables.
+                 */
+                template<typename Type>
+                class fixed_base_accumulation_vector {
+                    using underlying_value_type = typename Type::value_type;
+
+                public:
+                    using group_type = Type;
+
+                    underlying_value_type first;
+                    std::vector<std::size_t> indices;
+                    std::vector<algebra::window_table<Type>> tables;
+                    std::size_t scalar_size;
+                    std::size_t window;
+
+                    fixed_base_accumulation_vector() :
+                        first(underlying_value_type::zero()), scalar_size(0), window(0), domain_size_(0) {
+                    }
+
+                    fixed_base_accumulation_vector(const accumulation_vector<Type> &other, std::size_t scalar_size,
+                                                   std::size_t window) :
+                        first(other.first),
+                        indices(other.rest.indices), tables(other.rest.indices.size()), scalar_size(scalar_size),
+                        window(window), domain_size_(other.domain_size()) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < tables.size(); ++i) {
+                            tables[i] = algebra::get_window_table<Type>(scalar_size, window, other.rest.values[i]);
+                        }
+                    }
+
+                    /* number of points in the table of one base: one row of 2^window points per window */
+                    static std::size_t table_size(std::size_t scalar_size, std::size_t window) {
+                        return ((scalar_size + window - 1) / window) << window;
+                    }
+
+                    bool empty() const {
+                        return tables.empty();
+                    }
+
+                    std::size_t domain_size() const {
+                        return domain_size_;
+                    }
+
+                    /* first + sum_i input[i] * base_i, inputs past the end of [begin, end) being zero */
+                    template<typename InputIterator>
+                    underlying_value_type accumulate(InputIterator begin, InputIterator end) const {
+                        typedef typename std::iterator_traits<InputIterator>::value_type::field_type field_type;
+
+                        const std::size_t input_size = std::distance(begin, end);
+                        underlying_value_type result = first;
+                        for (std::size_t i = 0; i < indices.size() && indices[i] < input_size; ++i) {
+                            const auto &scalar = *(begin + indices[i]);
+                            if (!scalar.is_zero()) {
+                                result = result + algebra::windowed_exp<Type, field_type>(scalar_size, window,
+                                                                                          tables[i], scalar);
+                            }
+                        }
+                        return result;
+                    }
+
+                private:
+                    std::size_t domain_size_;
                 };
             }    // namespace snark
         }        // namespace zk
@@ -27,6 +27,8 @@
 #ifndef CRYPTO3_ZK_SNARK_ALGORITHMS_GENERATE_HPP
 #define CRYPTO3_ZK_SNARK_ALGORITHMS_GENERATE_HPP
 
+#include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs_optimizer.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -43,6 +45,14 @@ namespace nil {
                     return ProofSystemType::template generate<KeyPairType>(circuit);
                 }
 
+                /* keys for a system shrunk by r1cs_optimizer; prove with the matching prove() overload */
+                template<typename ProofSystemType, typename KeyPairType = typename ProofSystemType::keypair_type,
+                         typename FieldType>
+                KeyPairType generate(const r1cs_optimized_constraint_system<FieldType> &optimized) {
+
+                    return ProofSystemType::template generate<KeyPairType>(optimized.constraint_system);
+                }
+
                 template<typename ProofSystemType>
                 typename ProofSystemType::srs_pair_type generate(std::size_t num_proofs) {
 
@@ -27,6 +27,8 @@
 #ifndef CRYPTO3_ZK_SNARK_ALGORITHMS_PROVE_HPP
 #define CRYPTO3_ZK_SNARK_ALGORITHMS_PROVE_HPP
 
+#include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs_optimizer.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -40,6 +42,17 @@ namespace nil {
                     return ProofSystemType::prove(pk, primary_input, auxiliary_input);
                 }
 
+                /* pk was generated from optimized; the witness is one of the original, unoptimized system */
+                template<typename ProofSystemType, typename FieldType>
+                typename ProofSystemType::proof_type
+                    prove(const typename ProofSystemType::proving_key_type &pk,
+                          const r1cs_optimized_constraint_system<FieldType> &optimized,
+                          const typename ProofSystemType::primary_input_type &primary_input,
+                          const typename ProofSystemType::auxiliary_input_type &auxiliary_input) {
+
+                    return ProofSystemType::prove(pk, primary_input, optimized.auxiliary_input_map(auxiliary_input));
+                }
+
                 template<typename ProofSystemType,
                          typename Hash,
                          typename InputTranscriptIncludeIterator,
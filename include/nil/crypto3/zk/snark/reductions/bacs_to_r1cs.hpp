@@ -36,6 +36,7 @@
 
 #include <nil/crypto3/zk/snark/relations/circuit_satisfaction_problems/bacs.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs.hpp>
+#include <nil/crypto3/zk/snark/reductions/r1cs_to_qap.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -81,6 +82,62 @@ namespace nil {
                                 circuit.get_all_wires(primary_input, auxiliary_input);
                             return result;
                         }
+
+                        /**
+                         * Witness map for the BACS-to-R1CS reduction fused with the evaluation of the R1CS
+                         * constraints, for r1cs_to_qap::witness_map_from_evaluations().
+                         *
+                         * The levelized circuit is evaluated once, directly into the full variable assignment of
+                         * the QAP witness held by the workspace; the lhs, rhs and output of every gate are at the
+                         * same time the values of the A, B and C sides of its constraint, and every circuit output
+                         * gives the values (1, output, 0) of its output constraint. If swap_AB is set, the A and B
+                         * values are exchanged, to match a system the generator swapped, see is_swapped_AB().
+                         */
+                        static void witness_map(const bacs_levelized_circuit<FieldType> &circuit,
+                                                const bacs_primary_input<FieldType> &primary_input,
+                                                const bacs_auxiliary_input<FieldType> &auxiliary_input,
+                                                bool swap_AB,
+                                                typename r1cs_to_qap<FieldType>::workspace_type &workspace) {
+                            assert(primary_input.size() + auxiliary_input.size() == circuit.num_inputs);
+
+                            r1cs_variable_assignment<FieldType> &wires = workspace.witness.coefficients_for_ABCs;
+                            wires.assign(primary_input.begin(), primary_input.end());
+                            wires.insert(wires.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+                            std::vector<typename FieldType::value_type> &aA = workspace.aA, &aB = workspace.aB,
+                                                                        &aC = workspace.aC;
+                            std::vector<typename FieldType::value_type> &lhs = swap_AB ? aB : aA,
+                                                                        &rhs = swap_AB ? aA : aB;
+                            circuit.evaluate(wires, &lhs, &rhs);
+                            aC.assign(wires.begin() + circuit.num_inputs, wires.end());
+
+                            for (std::size_t w : circuit.output_wires) {
+                                lhs.push_back(FieldType::value_type::one());
+                                rhs.push_back(wires[w]);
+                                aC.push_back(FieldType::value_type::zero());
+                            }
+                        }
+
+                        /**
+                         * Whether cs, the image of circuit by instance_map(), had its A and B sides swapped
+                         * afterwards, as the r1cs_ppzksnark generator does by swap_AB_if_beneficial(). The swap
+                         * applies to all constraints or none, so the first constraint telling both sides apart
+                         * decides.
+                         */
+                        static bool is_swapped_AB(const bacs_circuit<FieldType> &circuit,
+                                                  const r1cs_constraint_system<FieldType> &cs) {
+                            assert(cs.num_constraints() >= circuit.gates.size());
+
+                            for (std::size_t i = 0; i < circuit.gates.size(); ++i) {
+                                if (!(circuit.gates[i].lhs == circuit.gates[i].rhs)) {
+                                    return !(cs.constraints[i].a == circuit.gates[i].lhs);
+                                }
+                            }
+
+                            /* every gate squares its input, only an output constraint (1, output, 0) can tell */
+                            return cs.num_constraints() > circuit.gates.size() &&
+                                   !(cs.constraints[circuit.gates.size()].a == linear_combination<FieldType>(1));
+                        }
                     };
                 }    // namespace reductions
             }        // namespace snark
@@ -0,0 +1,173 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_REDUCTIONS_DETAIL_COSET_HPP
+#define CRYPTO3_ZK_REDUCTIONS_DETAIL_COSET_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/algebra/fields/params.hpp>
+
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+
+#include <nil/crypto3/zk/snark/reductions/detail/powers.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace reductions {
+                    namespace detail {
+
+                        /**
+                         * Powers of the multiplicative generator g used to move evaluations to the coset g*S and
+                         * back: powers[i] = g^i, inverse_powers[i] = g^{-i} for i < m.
+                         *
+                         * The table depends only on the domain size, so it is computed once per domain instead of
+                         * re-running the power chain in every math::multiply_by_coset call.
+                         */
+                        template<typename FieldType>
+                        struct coset_table {
+                            typedef typename FieldType::value_type value_type;
+
+                            coset_table() = default;
+
+                            explicit coset_table(std::size_t m) :
+                                powers(detail::powers<FieldType>(generator(), m)),
+                                inverse_powers(detail::powers<FieldType>(generator().inversed(), m)) {
+                            }
+
+                            static value_type generator() {
+                                return value_type(
+                                    algebra::fields::arithmetic_params<FieldType>::multiplicative_generator);
+                            }
+
+                            std::size_t size() const {
+                                return powers.size();
+                            }
+
+                            std::vector<value_type> powers;
+                            std::vector<value_type> inverse_powers;
+                        };
+
+                        /**
+                         * Evaluate on the coset g*S the polynomial with coefficients a: scale then FFT.
+                         */
+                        template<typename FieldType>
+                        void coset_fft(const std::shared_ptr<math::evaluation_domain<FieldType>> &domain,
+                                       std::vector<typename FieldType::value_type> &a,
+                                       const coset_table<FieldType> &coset) {
+                            BOOST_ASSERT(coset.size() >= a.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < a.size(); ++i) {
+                                a[i] *= coset.powers[i];
+                            }
+                            domain->fft(a);
+                        }
+
+                        /**
+                         * Interpolate evaluations a on the coset g*S: IFFT then unscale.
+                         */
+                        template<typename FieldType>
+                        void coset_inverse_fft(const std::shared_ptr<math::evaluation_domain<FieldType>> &domain,
+                                               std::vector<typename FieldType::value_type> &a,
+                                               const coset_table<FieldType> &coset) {
+                            BOOST_ASSERT(coset.size() >= a.size());
+                            domain->inverse_fft(a);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < a.size(); ++i) {
+                                a[i] *= coset.inverse_powers[i];
+                            }
+                        }
+
+                        /**
+                         * a[i] *= c^i without materializing the powers of c: as in powers(), every chunk runs its
+                         * own power chain starting from c^offset. Used when a coset_table does not fit in memory.
+                         */
+                        template<typename FieldType>
+                        void multiply_by_powers(std::vector<typename FieldType::value_type> &a,
+                                                const typename FieldType::value_type &c) {
+#ifdef MULTICORE
+                            const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                                 // var or call omp_set_num_threads()
+#else
+                            const std::size_t chunks = 1;
+#endif
+                            const std::size_t chunk_size = (a.size() + chunks - 1) / chunks;
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < chunks; ++i) {
+                                const std::size_t first = i * chunk_size,
+                                                  last = std::min(first + chunk_size, a.size());
+                                if (first >= last) {
+                                    continue;
+                                }
+
+                                typename FieldType::value_type ci = c.pow(first);
+                                for (std::size_t j = first; j < last; ++j) {
+                                    a[j] *= ci;
+                                    ci *= c;
+                                }
+                            }
+                        }
+
+                        /**
+                         * Same as coset_fft() and coset_inverse_fft() above, without a precomputed table.
+                         */
+                        template<typename FieldType>
+                        void coset_fft(const std::shared_ptr<math::evaluation_domain<FieldType>> &domain,
+                                       std::vector<typename FieldType::value_type> &a) {
+                            multiply_by_powers<FieldType>(a, coset_table<FieldType>::generator());
+                            domain->fft(a);
+                        }
+
+                        template<typename FieldType>
+                        void coset_inverse_fft(const std::shared_ptr<math::evaluation_domain<FieldType>> &domain,
+                                               std::vector<typename FieldType::value_type> &a) {
+                            domain->inverse_fft(a);
+                            multiply_by_powers<FieldType>(a, coset_table<FieldType>::generator().inversed());
+                        }
+                    }    // namespace detail
+                }        // namespace reductions
+            }            // namespace snark
+        }                // namespace zk
+    }                    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_REDUCTIONS_DETAIL_COSET_HPP
@@ -0,0 +1,213 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Selection of the evaluation domain of a reduction from a cost model.
+//
+// math::make_evaluation_domain() returns the first domain type that accepts a
+// size, in a fixed order. Here every radix-2 domain type is sized for the
+// requested number of points and the candidates are compared by the estimated
+// cost of proving over them: the FFTs of the witness map plus the
+// multi-exponentiation over the H query, whose length is the domain size.
+//
+// The sequence domains are never selected: the witness maps move evaluations
+// to a multiplicative coset, which only the radix-2 domains are used with.
+//
+// The selected size fixes the length of the H query, so it is part of the key
+// format: keys must be generated and used with the same selection.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_REDUCTIONS_DETAIL_DOMAIN_SELECTION_HPP
+#define CRYPTO3_ZK_REDUCTIONS_DETAIL_DOMAIN_SELECTION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <boost/assert.hpp>
+
+#include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/domains/basic_radix2_domain.hpp>
+#include <nil/crypto3/math/domains/extended_radix2_domain.hpp>
+#include <nil/crypto3/math/domains/step_radix2_domain.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace reductions {
+                    namespace detail {
+
+                        enum class domain_kind { basic_radix2, extended_radix2, step_radix2 };
+
+                        /**
+                         * A domain type together with the size it takes for a given number of points, and the
+                         * estimated cost, in field multiplications, of proving over it.
+                         */
+                        struct domain_choice {
+                            domain_kind kind;
+                            std::size_t size;
+                            double cost;
+                        };
+
+                        template<typename FieldType>
+                        struct domain_selection {
+                            typedef FieldType field_type;
+
+                            /**
+                             * Field multiplications of one (inverse) FFT over a domain of the given kind and size.
+                             *
+                             * Radix-2 FFTs take n/2 butterflies per layer. The extended domain runs two half-size
+                             * FFTs plus a coset shift, the step domain a big and a small FFT plus a twiddle pass.
+                             */
+                            static double fft_cost(domain_kind kind, std::size_t n) {
+                                const double log_n = std::log2(double(n));
+
+                                switch (kind) {
+                                    case domain_kind::basic_radix2:
+                                        return 0.5 * n * log_n;
+                                    case domain_kind::extended_radix2:
+                                        return 0.5 * n * (log_n - 1) + n;
+                                    case domain_kind::step_radix2: {
+                                        const double big = double(step_big(n)), small = double(n) - big;
+                                        return 0.5 * big * std::log2(big) + 0.5 * small * std::log2(small) + 2 * big +
+                                               small;
+                                    }
+                                }
+                                return 0;
+                            }
+
+                            /**
+                             * Field multiplications of a Pippenger multi-exponentiation of length n, counting a
+                             * mixed addition as 11 multiplications.
+                             */
+                            static double msm_cost(std::size_t n) {
+                                const double window = std::max(1.0, std::log2(double(n)) - 2);
+                                return n * 11 * (FieldType::modulus_bits / window + 1);
+                            }
+
+                            /**
+                             * The smallest size of the given kind holding at least m points, or 0 if the field
+                             * does not support such a domain.
+                             */
+                            static std::size_t candidate_size(domain_kind kind, std::size_t m) {
+                                if (m < 2) {
+                                    m = 2;
+                                }
+                                const std::size_t pow2 = next_power_of_two(m);
+
+                                std::size_t n = 0;
+                                switch (kind) {
+                                    case domain_kind::basic_radix2:
+                                        n = math::detail::is_basic_radix2_domain<FieldType>(pow2) ? pow2 : 0;
+                                        break;
+                                    case domain_kind::extended_radix2:
+                                        n = math::detail::is_extended_radix2_domain<FieldType>(pow2) ? pow2 : 0;
+                                        break;
+                                    case domain_kind::step_radix2: {
+                                        if (m == pow2) {
+                                            break;
+                                        }
+                                        const std::size_t big = pow2 / 2, small = next_power_of_two(m - big);
+                                        if (small < big &&
+                                            math::detail::is_step_radix2_domain<FieldType>(big + small)) {
+                                            n = big + small;
+                                        }
+                                        break;
+                                    }
+                                }
+                                return n;
+                            }
+
+                            /**
+                             * Every supported radix-2 domain type for m points with its estimated cost, for a
+                             * witness map doing num_ffts FFTs and a prover doing a multi-exponentiation of domain
+                             * size.
+                             */
+                            static std::vector<domain_choice> candidates(std::size_t m, std::size_t num_ffts) {
+                                std::vector<domain_choice> result;
+                                for (domain_kind kind : {domain_kind::basic_radix2, domain_kind::extended_radix2,
+                                                         domain_kind::step_radix2}) {
+                                    const std::size_t n = candidate_size(kind, m);
+                                    if (n != 0) {
+                                        result.push_back({kind, n, num_ffts * fft_cost(kind, n) + msm_cost(n + 1)});
+                                    }
+                                }
+                                return result;
+                            }
+
+                            /**
+                             * The cheapest candidate; ties go to the earlier kind, in make_evaluation_domain() order.
+                             */
+                            static domain_choice select(std::size_t m, std::size_t num_ffts) {
+                                const std::vector<domain_choice> choices = candidates(m, num_ffts);
+                                BOOST_ASSERT_MSG(!choices.empty(), "no radix-2 evaluation domain supports this size");
+
+                                domain_choice best = choices.front();
+                                for (const domain_choice &choice : choices) {
+                                    if (choice.cost < best.cost) {
+                                        best = choice;
+                                    }
+                                }
+                                return best;
+                            }
+
+                            static std::shared_ptr<math::evaluation_domain<FieldType>>
+                                make_domain(const domain_choice &choice) {
+                                typedef std::shared_ptr<math::evaluation_domain<FieldType>> result_type;
+
+                                switch (choice.kind) {
+                                    case domain_kind::basic_radix2:
+                                        return result_type(new math::basic_radix2_domain<FieldType>(choice.size));
+                                    case domain_kind::extended_radix2:
+                                        return result_type(new math::extended_radix2_domain<FieldType>(choice.size));
+                                    case domain_kind::step_radix2:
+                                        return result_type(new math::step_radix2_domain<FieldType>(choice.size));
+                                }
+                                return result_type();
+                            }
+
+                        private:
+                            static std::size_t next_power_of_two(std::size_t m) {
+                                std::size_t result = 1;
+                                while (result < m) {
+                                    result <<= 1;
+                                }
+                                return result;
+                            }
+
+                            /* the big radix-2 part of a step domain of size n */
+                            static std::size_t step_big(std::size_t n) {
+                                return next_power_of_two(n) / 2;
+                            }
+                        };
+                    }    // namespace detail
+                }        // namespace reductions
+            }            // namespace snark
+        }                // namespace zk
+    }                    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_REDUCTIONS_DETAIL_DOMAIN_SELECTION_HPP
@@ -0,0 +1,86 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_REDUCTIONS_DETAIL_POWERS_HPP
+#define CRYPTO3_ZK_REDUCTIONS_DETAIL_POWERS_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+                namespace reductions {
+                    namespace detail {
+
+                        /**
+                         * Compute (1, t, t^2, ..., t^{size-1}).
+                         *
+                         * The range is split into chunks; every chunk starts from its own t^offset, so the chunks
+                         * are independent power chains that can run in parallel.
+                         */
+                        template<typename FieldType>
+                        std::vector<typename FieldType::value_type> powers(const typename FieldType::value_type &t,
+                                                                           std::size_t size) {
+#ifdef MULTICORE
+                            const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                                 // var or call omp_set_num_threads()
+#else
+                            const std::size_t chunks = 1;
+#endif
+                            const std::size_t chunk_size = (size + chunks - 1) / chunks;
+
+                            std::vector<typename FieldType::value_type> result(size);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < chunks; ++i) {
+                                const std::size_t first = i * chunk_size, last = std::min(first + chunk_size, size);
+                                if (first >= last) {
+                                    continue;
+                                }
+
+                                typename FieldType::value_type ti = t.pow(first);
+                                for (std::size_t j = first; j < last; ++j) {
+                                    result[j] = ti;
+                                    ti *= t;
+                                }
+                            }
+
+                            return result;
+                        }
+                    }    // namespace detail
+                }        // namespace reductions
+            }            // namespace snark
+        }                // namespace zk
+    }                    // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_REDUCTIONS_DETAIL_POWERS_HPP
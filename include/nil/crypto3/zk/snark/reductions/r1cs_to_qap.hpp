@@ -48,10 +48,14 @@
 #ifndef CRYPTO3_ZK_R1CS_TO_QAP_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_R1CS_TO_QAP_BASIC_POLICY_HPP
 
-#include <nil/crypto3/math/coset.hpp>
+#include <algorithm>
+
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 #include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
+#include <nil/crypto3/zk/snark/reductions/detail/coset.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/domain_selection.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/powers.hpp>
 #include <nil/crypto3/zk/snark/relations/arithmetic_programs/qap.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs.hpp>
 
@@ -66,6 +70,55 @@ namespace nil {
                     struct r1cs_to_qap {
                         typedef FieldType field_type;
 
+                        /**
+                         * The evaluation domain type and size that will be used by the reduction for a given R1CS
+                         * instance: the cheapest one, under detail::domain_selection's cost model, for the seven
+                         * FFTs of witness_map() and the H query multi-exponentiation.
+                         */
+                        static detail::domain_choice get_domain_choice(const r1cs_constraint_system<FieldType> &cs) {
+                            return detail::domain_selection<FieldType>::select(
+                                cs.num_constraints() + cs.num_inputs() + 1, 7);
+                        }
+
+                        /**
+                         * Helper function to find evaluation domain that will be used by the reduction
+                         * for a given R1CS instance.
+                         */
+                        static std::shared_ptr<math::evaluation_domain<FieldType>>
+                            get_domain(const r1cs_constraint_system<FieldType> &cs) {
+                            return detail::domain_selection<FieldType>::make_domain(get_domain_choice(cs));
+                        }
+
+                        /**
+                         * Buffers of the witness map for a given R1CS instance.
+                         *
+                         * A workspace is created once per constraint system and passed to every witness_map()
+                         * call; the evaluation domain, its coset power tables, the evaluation vectors and the
+                         * resulting witness keep their storage between calls, so steady-state proving does not
+                         * allocate.
+                         */
+                        struct workspace_type {
+                            explicit workspace_type(const r1cs_constraint_system<FieldType> &cs) :
+                                domain(get_domain(cs)), coset(domain->m),
+                                witness(cs.num_variables(), domain->m, cs.num_inputs(), FieldType::value_type::zero(),
+                                        FieldType::value_type::zero(), FieldType::value_type::zero(),
+                                        std::vector<typename FieldType::value_type>(),
+                                        std::vector<typename FieldType::value_type>()) {
+                                aA.reserve(domain->m);
+                                aB.reserve(domain->m);
+                                aC.reserve(domain->m);
+                                witness.coefficients_for_ABCs.reserve(cs.num_variables());
+                                witness.coefficients_for_H.reserve(domain->m + 1);
+                            }
+
+                            std::shared_ptr<math::evaluation_domain<FieldType>> domain;
+                            detail::coset_table<FieldType> coset;
+
+                            std::vector<typename FieldType::value_type> aA, aB, aC;
+
+                            qap_witness<FieldType> witness;
+                        };
+
                         /**
                          * Instance map for the R1CS-to-QAP reduction.
                          *
@@ -80,45 +133,61 @@ namespace nil {
                          */
                         static qap_instance<FieldType> instance_map(const r1cs_constraint_system<FieldType> &cs) {
 
-                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain = get_domain(cs);
 
-                            std::vector<std::map<std::size_t, typename FieldType::value_type>> A_in_Lagrange_basis(
-                                cs.num_variables() + 1);
-                            std::vector<std::map<std::size_t, typename FieldType::value_type>> B_in_Lagrange_basis(
-                                cs.num_variables() + 1);
-                            std::vector<std::map<std::size_t, typename FieldType::value_type>> C_in_Lagrange_basis(
-                                cs.num_variables() + 1);
+                            typedef typename sparse_matrix<FieldType>::entry_type entry_type;
 
                             /**
-                             * add and process the constraints
-                             *     input_i * 0 = 0
-                             * to ensure soundness of input consistency
+                             * entries of constraint i start at A_offsets[i], B_offsets[i] and C_offsets[i], so
+                             * constraints fill them in parallel
                              */
-                            for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
-                                A_in_Lagrange_basis[i][cs.num_constraints() + i] = FieldType::value_type::one();
+                            std::vector<std::size_t> A_offsets(cs.num_constraints() + 1, 0),
+                                B_offsets(cs.num_constraints() + 1, 0), C_offsets(cs.num_constraints() + 1, 0);
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                A_offsets[i + 1] = A_offsets[i] + cs.constraints[i].a.terms.size();
+                                B_offsets[i + 1] = B_offsets[i] + cs.constraints[i].b.terms.size();
+                                C_offsets[i + 1] = C_offsets[i] + cs.constraints[i].c.terms.size();
                             }
-                            /* process all other constraints */
+                            const std::size_t inputs_offset = A_offsets[cs.num_constraints()];
+
+                            std::vector<entry_type> A_entries(inputs_offset + cs.num_inputs() + 1),
+                                B_entries(B_offsets[cs.num_constraints()]), C_entries(C_offsets[cs.num_constraints()]);
+
+                            /* process all constraints; column = variable, row = constraint */
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
                                 for (std::size_t j = 0; j < cs.constraints[i].a.terms.size(); ++j) {
-                                    A_in_Lagrange_basis[cs.constraints[i].a.terms[j].index][i] +=
-                                        cs.constraints[i].a.terms[j].coeff;
+                                    A_entries[A_offsets[i] + j] = {cs.constraints[i].a.terms[j].index, i,
+                                                                   cs.constraints[i].a.terms[j].coeff};
                                 }
 
                                 for (std::size_t j = 0; j < cs.constraints[i].b.terms.size(); ++j) {
-                                    B_in_Lagrange_basis[cs.constraints[i].b.terms[j].index][i] +=
-                                        cs.constraints[i].b.terms[j].coeff;
+                                    B_entries[B_offsets[i] + j] = {cs.constraints[i].b.terms[j].index, i,
+                                                                   cs.constraints[i].b.terms[j].coeff};
                                 }
 
                                 for (std::size_t j = 0; j < cs.constraints[i].c.terms.size(); ++j) {
-                                    C_in_Lagrange_basis[cs.constraints[i].c.terms[j].index][i] +=
-                                        cs.constraints[i].c.terms[j].coeff;
+                                    C_entries[C_offsets[i] + j] = {cs.constraints[i].c.terms[j].index, i,
+                                                                   cs.constraints[i].c.terms[j].coeff};
                                 }
                             }
+                            /**
+                             * add and process the constraints
+                             *     input_i * 0 = 0
+                             * to ensure soundness of input consistency
+                             */
+                            for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
+                                A_entries[inputs_offset + i] = {i, cs.num_constraints() + i,
+                                                                FieldType::value_type::one()};
+                            }
 
                             return qap_instance<FieldType>(
-                                domain, cs.num_variables(), domain->m, cs.num_inputs(), std::move(A_in_Lagrange_basis),
-                                std::move(B_in_Lagrange_basis), std::move(C_in_Lagrange_basis));
+                                domain, cs.num_variables(), domain->m, cs.num_inputs(),
+                                sparse_matrix<FieldType>(cs.num_variables() + 1, std::move(A_entries)),
+                                sparse_matrix<FieldType>(cs.num_variables() + 1, std::move(B_entries)),
+                                sparse_matrix<FieldType>(cs.num_variables() + 1, std::move(C_entries)));
                         }
 
                         /**
@@ -139,48 +208,24 @@ namespace nil {
                         static qap_instance_evaluation<FieldType>
                             instance_map_with_evaluation(const r1cs_constraint_system<FieldType> &cs,
                                                          const typename FieldType::value_type &t) {
-                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
-
-                            std::vector<typename FieldType::value_type> At, Bt, Ct, Ht;
-
-                            At.resize(cs.num_variables() + 1, FieldType::value_type::zero());
-                            Bt.resize(cs.num_variables() + 1, FieldType::value_type::zero());
-                            Ct.resize(cs.num_variables() + 1, FieldType::value_type::zero());
-                            Ht.reserve(domain->m + 1);
+                            /**
+                             * build the column-major Lagrange basis coefficients once and evaluate every column
+                             * (variable) at t independently: O(nnz) work split across threads without shared writes
+                             */
+                            const qap_instance<FieldType> instance = instance_map(cs);
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> &domain = instance.domain;
 
                             const typename FieldType::value_type Zt = domain->compute_vanishing_polynomial(t);
 
                             const std::vector<typename FieldType::value_type> u =
                                 domain->evaluate_all_lagrange_polynomials(t);
-                            /**
-                             * add and process the constraints
-                             *     input_i * 0 = 0
-                             * to ensure soundness of input consistency
-                             */
-                            for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
-                                At[i] = u[cs.num_constraints() + i];
-                            }
-                            /* process all other constraints */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                for (std::size_t j = 0; j < cs.constraints[i].a.terms.size(); ++j) {
-                                    At[cs.constraints[i].a.terms[j].index] += u[i] * cs.constraints[i].a.terms[j].coeff;
-                                }
-
-                                for (std::size_t j = 0; j < cs.constraints[i].b.terms.size(); ++j) {
-                                    Bt[cs.constraints[i].b.terms[j].index] += u[i] * cs.constraints[i].b.terms[j].coeff;
-                                }
 
-                                for (std::size_t j = 0; j < cs.constraints[i].c.terms.size(); ++j) {
-                                    Ct[cs.constraints[i].c.terms[j].index] += u[i] * cs.constraints[i].c.terms[j].coeff;
-                                }
-                            }
+                            std::vector<typename FieldType::value_type> At = instance.A_in_Lagrange_basis.evaluate(u),
+                                                                        Bt = instance.B_in_Lagrange_basis.evaluate(u),
+                                                                        Ct = instance.C_in_Lagrange_basis.evaluate(u);
 
-                            typename FieldType::value_type ti = FieldType::value_type::one();
-                            for (std::size_t i = 0; i < domain->m + 1; ++i) {
-                                Ht.emplace_back(ti);
-                                ti *= t;
-                            }
+                            std::vector<typename FieldType::value_type> Ht =
+                                detail::powers<FieldType>(t, domain->m + 1);
 
                             return qap_instance_evaluation<FieldType>(domain, cs.num_variables(), domain->m,
                                                                       cs.num_inputs(), t, std::move(At), std::move(Bt),
@@ -224,105 +269,323 @@ namespace nil {
                                         const typename FieldType::value_type &d1,
                                         const typename FieldType::value_type &d2,
                                         const typename FieldType::value_type &d3) {
+                            workspace_type workspace(cs);
+                            witness_map(cs, primary_input, auxiliary_input, d1, d2, d3, workspace);
+
+                            return std::move(workspace.witness);
+                        }
+
+                        /**
+                         * Witness map reusing the buffers of the workspace, which must have been created for cs.
+                         * The returned witness is owned by the workspace and is overwritten by the next call.
+                         */
+                        static const qap_witness<FieldType> &
+                            witness_map(const r1cs_constraint_system<FieldType> &cs,
+                                        const r1cs_primary_input<FieldType> &primary_input,
+                                        const r1cs_auxiliary_input<FieldType> &auxiliary_input,
+                                        const typename FieldType::value_type &d1,
+                                        const typename FieldType::value_type &d2,
+                                        const typename FieldType::value_type &d3,
+                                        workspace_type &workspace) {
                             /* sanity check */
                             assert(cs.is_satisfied(primary_input, auxiliary_input));
 
-                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints() + cs.num_inputs() + 1);
-
-                            r1cs_variable_assignment<FieldType> full_variable_assignment = primary_input;
+                            r1cs_variable_assignment<FieldType> &full_variable_assignment =
+                                workspace.witness.coefficients_for_ABCs;
+                            full_variable_assignment.assign(primary_input.begin(), primary_input.end());
                             full_variable_assignment.insert(full_variable_assignment.end(), auxiliary_input.begin(),
                                                             auxiliary_input.end());
 
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero()),
-                                aB(domain->m, FieldType::value_type::zero());
+                            std::vector<typename FieldType::value_type> &aA = workspace.aA, &aB = workspace.aB,
+                                                                        &aC = workspace.aC;
+                            aA.resize(cs.num_constraints());
+                            aB.resize(cs.num_constraints());
+                            aC.resize(cs.num_constraints());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                aA[i] = cs.constraints[i].a.evaluate(full_variable_assignment);
+                                aB[i] = cs.constraints[i].b.evaluate(full_variable_assignment);
+                                aC[i] = cs.constraints[i].c.evaluate(full_variable_assignment);
+                            }
+
+                            return witness_map_from_evaluations(cs, d1, d2, d3, workspace);
+                        }
+
+                        /**
+                         * Second half of witness_map(), for callers that already know the values of the
+                         * constraints, such as the circuit reductions: workspace.witness.coefficients_for_ABCs must
+                         * hold the full variable assignment, and the first cs.num_constraints() entries of
+                         * workspace.aA, aB and aC the values <A_i,X>, <B_i,X> and <C_i,X> of every constraint.
+                         */
+                        static const qap_witness<FieldType> &
+                            witness_map_from_evaluations(const r1cs_constraint_system<FieldType> &cs,
+                                                         const typename FieldType::value_type &d1,
+                                                         const typename FieldType::value_type &d2,
+                                                         const typename FieldType::value_type &d3,
+                                                         workspace_type &workspace) {
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> &domain = workspace.domain;
+                            assert(domain->m >= cs.num_constraints() + cs.num_inputs() + 1);
+
+                            qap_witness<FieldType> &witness = workspace.witness;
+                            assert(witness.coefficients_for_ABCs.size() == cs.num_variables());
+                            witness.num_variables = cs.num_variables();
+                            witness.degree = domain->m;
+                            witness.num_inputs = cs.num_inputs();
+                            witness.d1 = d1;
+                            witness.d2 = d2;
+                            witness.d3 = d3;
+
+                            const r1cs_variable_assignment<FieldType> &full_variable_assignment =
+                                witness.coefficients_for_ABCs;
+
+                            std::vector<typename FieldType::value_type> &aA = workspace.aA, &aB = workspace.aB,
+                                                                        &aC = workspace.aC;
+                            aA.resize(domain->m);
+                            aB.resize(domain->m);
+                            aC.resize(domain->m);
+                            std::fill(aA.begin() + cs.num_constraints(), aA.end(), FieldType::value_type::zero());
+                            std::fill(aB.begin() + cs.num_constraints(), aB.end(), FieldType::value_type::zero());
+                            std::fill(aC.begin() + cs.num_constraints(), aC.end(), FieldType::value_type::zero());
 
                             /* account for the additional constraints input_i * 0 = 0 */
                             for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
                                 aA[i + cs.num_constraints()] =
                                     (i > 0 ? full_variable_assignment[i - 1] : FieldType::value_type::one());
                             }
-                            /* account for all other constraints */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[i] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aB[i] += cs.constraints[i].b.evaluate(full_variable_assignment);
-                            }
 
                             domain->inverse_fft(aA);
 
                             domain->inverse_fft(aB);
 
-                            std::vector<typename FieldType::value_type> coefficients_for_H(
-                                domain->m + 1, FieldType::value_type::zero());
+                            const detail::coset_table<FieldType> &coset = workspace.coset;
+                            std::vector<typename FieldType::value_type> &coefficients_for_H =
+                                witness.coefficients_for_H;
+                            coefficients_for_H.assign(domain->m + 1, FieldType::value_type::zero());
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
-                            /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z */
+                            /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z, and move A and B
+                             * to the coset g*S in the same pass */
                             for (std::size_t i = 0; i < domain->m; ++i) {
                                 coefficients_for_H[i] = d2 * aA[i] + d1 * aB[i];
+                                aA[i] *= coset.powers[i];
+                                aB[i] *= coset.powers[i];
                             }
                             coefficients_for_H[0] -= d3;
                             domain->add_poly_z(d1 * d2, coefficients_for_H);
 
-                            math::multiply_by_coset(
-                                aA,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
                             domain->fft(aA);
 
-                            math::multiply_by_coset(
-                                aB,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
                             domain->fft(aB);
 
+                            domain->inverse_fft(aC);
+
+                            detail::coset_fft(domain, aC, coset);
+
                             std::vector<typename FieldType::value_type> &H_tmp = aA;
                             // can overwrite aA because it is not used later
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
                             for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = aA[i] * aB[i];
+                                H_tmp[i] = aA[i] * aB[i] - aC[i];
                             }
-                            std::vector<typename FieldType::value_type>().swap(aB);    // destroy aB
 
-                            std::vector<typename FieldType::value_type> aC(domain->m, FieldType::value_type::zero());
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aC[i] += cs.constraints[i].c.evaluate(full_variable_assignment);
-                            }
-
-                            domain->inverse_fft(aC);
+                            domain->divide_by_z_on_coset(H_tmp);
 
-                            math::multiply_by_coset(
-                                aC,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aC);
+                            domain->inverse_fft(H_tmp);
 
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
+                            /* move H back from the coset while accumulating it */
                             for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = (H_tmp[i] - aC[i]);
+                                coefficients_for_H[i] += H_tmp[i] * coset.inverse_powers[i];
                             }
 
-                            domain->divide_by_z_on_coset(H_tmp);
+                            return witness;
+                        }
+
+                        /**
+                         * Peak size, in bytes, of the buffers that witness_map_with_memory_budget() itself
+                         * allocates for cs, all of which are live at the same time once C is on the coset:
+                         *   - the full variable assignment (cs.num_variables() elements, returned in the witness);
+                         *   - the buffer accumulating A*B-C and then H (m + 1 elements);
+                         *   - the buffer holding B and then C (m elements);
+                         *   - the coefficients of H when the ZK patch (d1, d2, d3) is not zero (m + 1 elements);
+                         *   - the coset power tables when cache_coset is set (2 * m elements).
+                         * The evaluation domain and any scratch space of its FFTs, the constraint system and the
+                         * inputs are not accounted for.
+                         */
+                        static std::size_t witness_map_peak_bytes(const r1cs_constraint_system<FieldType> &cs,
+                                                                  bool zk_patch,
+                                                                  bool cache_coset) {
+                            const std::size_t m = get_domain_choice(cs).size;
+
+                            return (cs.num_variables() + (m + 1) + m + (zk_patch ? m + 1 : 0) +
+                                    (cache_coset ? 2 * m : 0)) *
+                                   sizeof(typename FieldType::value_type);
+                        }
+
+                        /**
+                         * Witness map keeping its peak memory low, for packing several provers on one host.
+                         *
+                         * A, B and C are carried to the coset one after the other through two m-sized buffers:
+                         * the first accumulates A*B-C, the second is reused for B and then for C and released
+                         * before H is interpolated. Without a ZK patch, H is computed in place in the first
+                         * buffer. The constraints are evaluated in parallel, as in witness_map().
+                         *
+                         * memory_budget only controls the coset power tables, the one optional buffer: they are
+                         * built if witness_map_peak_bytes() with them fits in the budget, otherwise the powers
+                         * are recomputed on the fly. The other buffers are always needed, so peak_bytes, which
+                         * receives witness_map_peak_bytes() for the chosen mode, exceeds memory_budget whenever
+                         * even the mode without tables does not fit.
+                         */
+                        static qap_witness<FieldType>
+                            witness_map_with_memory_budget(const r1cs_constraint_system<FieldType> &cs,
+                                                           const r1cs_primary_input<FieldType> &primary_input,
+                                                           const r1cs_auxiliary_input<FieldType> &auxiliary_input,
+                                                           const typename FieldType::value_type &d1,
+                                                           const typename FieldType::value_type &d2,
+                                                           const typename FieldType::value_type &d3,
+                                                           std::size_t memory_budget,
+                                                           std::size_t &peak_bytes) {
+                            /* sanity check */
+                            assert(cs.is_satisfied(primary_input, auxiliary_input));
+
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain = get_domain(cs);
+
+                            const bool zk_patch = !(d1.is_zero() && d2.is_zero() && d3.is_zero());
+                            const bool cache_coset = witness_map_peak_bytes(cs, zk_patch, true) <= memory_budget;
+                            peak_bytes = witness_map_peak_bytes(cs, zk_patch, cache_coset);
+
+                            detail::coset_table<FieldType> coset;
+                            if (cache_coset) {
+                                coset = detail::coset_table<FieldType>(domain->m);
+                            }
+
+                            qap_witness<FieldType> witness(cs.num_variables(), domain->m, cs.num_inputs(), d1, d2, d3,
+                                                           std::vector<typename FieldType::value_type>(),
+                                                           std::vector<typename FieldType::value_type>());
+
+                            r1cs_variable_assignment<FieldType> &full_variable_assignment =
+                                witness.coefficients_for_ABCs;
+                            full_variable_assignment.reserve(cs.num_variables());
+                            full_variable_assignment.assign(primary_input.begin(), primary_input.end());
+                            full_variable_assignment.insert(full_variable_assignment.end(), auxiliary_input.begin(),
+                                                            auxiliary_input.end());
+
+                            std::vector<typename FieldType::value_type> &coefficients_for_H =
+                                witness.coefficients_for_H;
+                            if (zk_patch) {
+                                coefficients_for_H.assign(domain->m + 1, FieldType::value_type::zero());
+                            }
+
+                            /* H_tmp ends up holding A*B-C on the coset, tmp holds B and then C */
+                            std::vector<typename FieldType::value_type> H_tmp, tmp;
+                            H_tmp.reserve(domain->m + 1);
+                            H_tmp.assign(domain->m, FieldType::value_type::zero());
 
+                            /* account for the additional constraints input_i * 0 = 0 */
+                            for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
+                                H_tmp[i + cs.num_constraints()] =
+                                    (i > 0 ? full_variable_assignment[i - 1] : FieldType::value_type::one());
+                            }
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                H_tmp[i] = cs.constraints[i].a.evaluate(full_variable_assignment);
+                            }
                             domain->inverse_fft(H_tmp);
+                            if (zk_patch) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                                for (std::size_t i = 0; i < domain->m; ++i) {
+                                    coefficients_for_H[i] = d2 * H_tmp[i];
+                                }
+                            }
+                            if (cache_coset) {
+                                detail::coset_fft(domain, H_tmp, coset);
+                            } else {
+                                detail::coset_fft(domain, H_tmp);
+                            }
 
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                  fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                  .inversed());
+                            tmp.assign(domain->m, FieldType::value_type::zero());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                tmp[i] = cs.constraints[i].b.evaluate(full_variable_assignment);
+                            }
+                            domain->inverse_fft(tmp);
+                            if (zk_patch) {
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                                for (std::size_t i = 0; i < domain->m; ++i) {
+                                    coefficients_for_H[i] += d1 * tmp[i];
+                                }
+                            }
+                            if (cache_coset) {
+                                detail::coset_fft(domain, tmp, coset);
+                            } else {
+                                detail::coset_fft(domain, tmp);
+                            }
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
                             for (std::size_t i = 0; i < domain->m; ++i) {
-                                coefficients_for_H[i] += H_tmp[i];
+                                H_tmp[i] *= tmp[i];
+                            }
+
+                            tmp.assign(domain->m, FieldType::value_type::zero());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                tmp[i] = cs.constraints[i].c.evaluate(full_variable_assignment);
+                            }
+                            domain->inverse_fft(tmp);
+                            if (cache_coset) {
+                                detail::coset_fft(domain, tmp, coset);
+                            } else {
+                                detail::coset_fft(domain, tmp);
+                            }
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < domain->m; ++i) {
+                                H_tmp[i] -= tmp[i];
+                            }
+                            std::vector<typename FieldType::value_type>().swap(tmp);
+
+                            domain->divide_by_z_on_coset(H_tmp);
+                            if (cache_coset) {
+                                detail::coset_inverse_fft(domain, H_tmp, coset);
+                            } else {
+                                detail::coset_inverse_fft(domain, H_tmp);
+                            }
+
+                            if (zk_patch) {
+                                /* add coefficients of the polynomial (d2*A + d1*B - d3) + d1*d2*Z */
+                                coefficients_for_H[0] -= d3;
+                                domain->add_poly_z(d1 * d2, coefficients_for_H);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                                for (std::size_t i = 0; i < domain->m; ++i) {
+                                    coefficients_for_H[i] += H_tmp[i];
+                                }
+                            } else {
+                                H_tmp.push_back(FieldType::value_type::zero());
+                                coefficients_for_H.swap(H_tmp);
                             }
 
-                            return qap_witness<FieldType>(cs.num_variables(), domain->m, cs.num_inputs(), d1, d2, d3,
-                                                          full_variable_assignment, std::move(coefficients_for_H));
+                            return witness;
                         }
                     };
                 }    // namespace reductions
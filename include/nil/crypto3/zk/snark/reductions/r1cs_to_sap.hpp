@@ -49,9 +49,11 @@
 #ifndef CRYPTO3_ZK_R1CS_TO_SAP_BASIC_POLICY_HPP
 #define CRYPTO3_ZK_R1CS_TO_SAP_BASIC_POLICY_HPP
 
-#include <nil/crypto3/math/coset.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
+#include <nil/crypto3/zk/snark/reductions/detail/coset.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/domain_selection.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/powers.hpp>
 #include <nil/crypto3/zk/snark/relations/arithmetic_programs/sap.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs.hpp>
 
@@ -74,11 +76,11 @@ namespace nil {
 
                     public:
                         /**
-                         * Helper function to find evaluation domain that will be used by the reduction
-                         * for a given R1CS instance.
+                         * The evaluation domain type and size that will be used by the reduction for a given R1CS
+                         * instance: the cheapest one, under detail::domain_selection's cost model, for the five
+                         * FFTs of witness_map() and the H query multi-exponentiation.
                          */
-                        static std::shared_ptr<math::evaluation_domain<FieldType>>
-                            get_domain(const r1cs_constraint_system<FieldType> &cs) {
+                        static detail::domain_choice get_domain_choice(const r1cs_constraint_system<FieldType> &cs) {
                             /*
                              * the SAP instance will have:
                              * - two constraints for every constraint in the original constraint system
@@ -87,10 +89,48 @@ namespace nil {
                              * see comments in instance_map for details on where these
                              * constraints come from.
                              */
-                            return math::make_evaluation_domain<FieldType>(2 * cs.num_constraints() +
-                                                                          2 * cs.num_inputs() + 1);
+                            return detail::domain_selection<FieldType>::select(
+                                2 * cs.num_constraints() + 2 * cs.num_inputs() + 1, 5);
+                        }
+
+                        /**
+                         * Helper function to find evaluation domain that will be used by the reduction
+                         * for a given R1CS instance.
+                         */
+                        static std::shared_ptr<math::evaluation_domain<FieldType>>
+                            get_domain(const r1cs_constraint_system<FieldType> &cs) {
+                            return detail::domain_selection<FieldType>::make_domain(get_domain_choice(cs));
                         }
 
+                        /**
+                         * Buffers of the witness map for a given R1CS instance.
+                         *
+                         * A workspace is created once per constraint system and passed to every witness_map()
+                         * call; the evaluation domain, its coset power tables, the evaluation vectors and the
+                         * resulting witness keep their storage between calls, so steady-state proving does not
+                         * allocate.
+                         */
+                        struct workspace_type {
+                            explicit workspace_type(const r1cs_constraint_system<FieldType> &cs) :
+                                domain(get_domain(cs)), coset(domain->m),
+                                witness(cs.num_variables() + cs.num_constraints() + cs.num_inputs(), domain->m,
+                                        cs.num_inputs(), FieldType::value_type::zero(), FieldType::value_type::zero(),
+                                        std::vector<typename FieldType::value_type>(),
+                                        std::vector<typename FieldType::value_type>()) {
+                                aA.reserve(domain->m);
+                                aC.reserve(domain->m);
+                                witness.coefficients_for_ACs.reserve(witness.num_variables);
+                                witness.coefficients_for_H.reserve(domain->m + 1);
+                            }
+
+                            std::shared_ptr<math::evaluation_domain<FieldType>> domain;
+                            detail::coset_table<FieldType> coset;
+
+                            std::vector<typename FieldType::value_type> aA, aC;
+
+                            sap_witness<FieldType> witness;
+                        };
+
                         /**
                          * Instance map for the R1CS-to-SAP reduction.
                          */
@@ -99,8 +139,24 @@ namespace nil {
 
                             std::size_t sap_num_variables = cs.num_variables() + cs.num_constraints() + cs.num_inputs();
 
-                            std::vector<std::map<std::size_t, typename FieldType::value_type>> A_in_Lagrange_basis(sap_num_variables + 1);
-                            std::vector<std::map<std::size_t, typename FieldType::value_type>> C_in_Lagrange_basis(sap_num_variables + 1);
+                            typedef typename sparse_matrix<FieldType>::entry_type entry_type;
+
+                            /**
+                             * entries of constraint i start at A_offsets[i] and C_offsets[i], so constraints fill
+                             * them in parallel; the entries of the input constraints follow
+                             */
+                            std::vector<std::size_t> A_offsets(cs.num_constraints() + 1, 0),
+                                C_offsets(cs.num_constraints() + 1, 0);
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                A_offsets[i + 1] = A_offsets[i] + 2 * (cs.constraints[i].a.terms.size() +
+                                                                       cs.constraints[i].b.terms.size());
+                                C_offsets[i + 1] = C_offsets[i] + cs.constraints[i].c.terms.size() + 2;
+                            }
+                            std::size_t A_next = A_offsets[cs.num_constraints()],
+                                        C_next = C_offsets[cs.num_constraints()];
+
+                            std::vector<entry_type> A_entries(A_next + 1 + 4 * cs.num_inputs()),
+                                C_entries(C_next + 1 + 3 * cs.num_inputs());
 
                             /**
                              * process R1CS constraints, converting a constraint of the form
@@ -117,28 +173,33 @@ namespace nil {
                              *   (numbered cs.num_variables() + 1 .. cs.num_variables() + cs.num_constraints())
                              */
                             std::size_t extra_var_offset = cs.num_variables() + 1;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                std::size_t A_k = A_offsets[i], C_k = C_offsets[i];
+
                                 for (std::size_t j = 0; j < cs.constraints[i].a.terms.size(); ++j) {
-                                    A_in_Lagrange_basis[cs.constraints[i].a.terms[j].index][2 * i] +=
-                                        cs.constraints[i].a.terms[j].coeff;
-                                    A_in_Lagrange_basis[cs.constraints[i].a.terms[j].index][2 * i + 1] +=
-                                        cs.constraints[i].a.terms[j].coeff;
+                                    A_entries[A_k++] = {cs.constraints[i].a.terms[j].index, 2 * i,
+                                                        cs.constraints[i].a.terms[j].coeff};
+                                    A_entries[A_k++] = {cs.constraints[i].a.terms[j].index, 2 * i + 1,
+                                                        cs.constraints[i].a.terms[j].coeff};
                                 }
 
                                 for (std::size_t j = 0; j < cs.constraints[i].b.terms.size(); ++j) {
-                                    A_in_Lagrange_basis[cs.constraints[i].b.terms[j].index][2 * i] +=
-                                        cs.constraints[i].b.terms[j].coeff;
-                                    A_in_Lagrange_basis[cs.constraints[i].b.terms[j].index][2 * i + 1] -=
-                                        cs.constraints[i].b.terms[j].coeff;
+                                    A_entries[A_k++] = {cs.constraints[i].b.terms[j].index, 2 * i,
+                                                        cs.constraints[i].b.terms[j].coeff};
+                                    A_entries[A_k++] = {cs.constraints[i].b.terms[j].index, 2 * i + 1,
+                                                        -cs.constraints[i].b.terms[j].coeff};
                                 }
 
                                 for (std::size_t j = 0; j < cs.constraints[i].c.terms.size(); ++j) {
-                                    C_in_Lagrange_basis[cs.constraints[i].c.terms[j].index][2 * i] +=
-                                        times_four(cs.constraints[i].c.terms[j].coeff);
+                                    C_entries[C_k++] = {cs.constraints[i].c.terms[j].index, 2 * i,
+                                                        times_four(cs.constraints[i].c.terms[j].coeff)};
                                 }
 
-                                C_in_Lagrange_basis[extra_var_offset + i][2 * i] += FieldType::value_type::one();
-                                C_in_Lagrange_basis[extra_var_offset + i][2 * i + 1] += FieldType::value_type::one();
+                                C_entries[C_k++] = {extra_var_offset + i, 2 * i, FieldType::value_type::one()};
+                                C_entries[C_k++] = {extra_var_offset + i, 2 * i + 1, FieldType::value_type::one()};
                             }
 
                             /**
@@ -169,31 +230,32 @@ namespace nil {
                              *     1 below
                              */
 
-                            A_in_Lagrange_basis[0][extra_constr_offset] = FieldType::value_type::one();
-                            C_in_Lagrange_basis[0][extra_constr_offset] = FieldType::value_type::one();
+                            A_entries[A_next++] = {0, extra_constr_offset, FieldType::value_type::one()};
+                            C_entries[C_next++] = {0, extra_constr_offset, FieldType::value_type::one()};
 
                             for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
-                                A_in_Lagrange_basis[i][extra_constr_offset + 2 * i - 1] +=
-                                    FieldType::value_type::one();
-                                A_in_Lagrange_basis[0][extra_constr_offset + 2 * i - 1] +=
-                                    FieldType::value_type::one();
-                                C_in_Lagrange_basis[i][extra_constr_offset + 2 * i - 1] +=
-                                    times_four(FieldType::value_type::one());
-                                C_in_Lagrange_basis[extra_var_offset2 + i][extra_constr_offset + 2 * i - 1] +=
-                                    FieldType::value_type::one();
-
-                                A_in_Lagrange_basis[i][extra_constr_offset + 2 * i] += FieldType::value_type::one();
-                                A_in_Lagrange_basis[0][extra_constr_offset + 2 * i] -= FieldType::value_type::one();
-                                C_in_Lagrange_basis[extra_var_offset2 + i][2 * cs.num_constraints() + 2 * i] +=
-                                    FieldType::value_type::one();
+                                A_entries[A_next++] = {i, extra_constr_offset + 2 * i - 1,
+                                                       FieldType::value_type::one()};
+                                A_entries[A_next++] = {0, extra_constr_offset + 2 * i - 1,
+                                                       FieldType::value_type::one()};
+                                C_entries[C_next++] = {i, extra_constr_offset + 2 * i - 1,
+                                                       times_four(FieldType::value_type::one())};
+                                C_entries[C_next++] = {extra_var_offset2 + i, extra_constr_offset + 2 * i - 1,
+                                                       FieldType::value_type::one()};
+
+                                A_entries[A_next++] = {i, extra_constr_offset + 2 * i, FieldType::value_type::one()};
+                                A_entries[A_next++] = {0, extra_constr_offset + 2 * i, -FieldType::value_type::one()};
+                                C_entries[C_next++] = {extra_var_offset2 + i, 2 * cs.num_constraints() + 2 * i,
+                                                       FieldType::value_type::one()};
                             }
 
-                            return sap_instance<FieldType>(domain,
-                                                           sap_num_variables,
-                                                           domain->m,
-                                                           cs.num_inputs(),
-                                                           std::move(A_in_Lagrange_basis),
-                                                           std::move(C_in_Lagrange_basis));
+                            return sap_instance<FieldType>(
+                                domain,
+                                sap_num_variables,
+                                domain->m,
+                                cs.num_inputs(),
+                                sparse_matrix<FieldType>(sap_num_variables + 1, std::move(A_entries)),
+                                sparse_matrix<FieldType>(sap_num_variables + 1, std::move(C_entries)));
                         }
 
                         /**
@@ -203,74 +265,26 @@ namespace nil {
                         static sap_instance_evaluation<FieldType>
                             instance_map_with_evaluation(const r1cs_constraint_system<FieldType> &cs,
                                                          const typename FieldType::value_type &t) {
-
-                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain = get_domain(cs);
-
-                            std::size_t sap_num_variables = cs.num_variables() + cs.num_constraints() + cs.num_inputs();
-
-                            std::vector<typename FieldType::value_type> At, Ct, Ht;
-
-                            At.resize(sap_num_variables + 1, FieldType::value_type::zero());
-                            Ct.resize(sap_num_variables + 1, FieldType::value_type::zero());
-                            Ht.reserve(domain->m + 1);
+                            /**
+                             * build the column-major Lagrange basis coefficients once (including the extra
+                             * constraints and variables of instance_map) and evaluate them at t
+                             */
+                            const sap_instance<FieldType> instance = instance_map(cs);
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> &domain = instance.domain;
 
                             const typename FieldType::value_type Zt = domain->compute_vanishing_polynomial(t);
 
                             const std::vector<typename FieldType::value_type> u =
                                 domain->evaluate_all_lagrange_polynomials(t);
-                            /**
-                             * add and process all constraints as in instance_map
-                             */
-                            std::size_t extra_var_offset = cs.num_variables() + 1;
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                for (std::size_t j = 0; j < cs.constraints[i].a.terms.size(); ++j) {
-                                    At[cs.constraints[i].a.terms[j].index] +=
-                                        u[2 * i] * cs.constraints[i].a.terms[j].coeff;
-                                    At[cs.constraints[i].a.terms[j].index] +=
-                                        u[2 * i + 1] * cs.constraints[i].a.terms[j].coeff;
-                                }
-
-                                for (std::size_t j = 0; j < cs.constraints[i].b.terms.size(); ++j) {
-                                    At[cs.constraints[i].b.terms[j].index] +=
-                                        u[2 * i] * cs.constraints[i].b.terms[j].coeff;
-                                    At[cs.constraints[i].b.terms[j].index] -=
-                                        u[2 * i + 1] * cs.constraints[i].b.terms[j].coeff;
-                                }
-
-                                for (std::size_t j = 0; j < cs.constraints[i].c.terms.size(); ++j) {
-                                    Ct[cs.constraints[i].c.terms[j].index] +=
-                                        times_four(u[2 * i] * cs.constraints[i].c.terms[j].coeff);
-                                }
-
-                                Ct[extra_var_offset + i] += u[2 * i];
-                                Ct[extra_var_offset + i] += u[2 * i + 1];
-                            }
-
-                            std::size_t extra_constr_offset = 2 * cs.num_constraints();
-                            std::size_t extra_var_offset2 = cs.num_variables() + cs.num_constraints();
 
-                            At[0] += u[extra_constr_offset];
-                            Ct[0] += u[extra_constr_offset];
+                            std::vector<typename FieldType::value_type> At = instance.A_in_Lagrange_basis.evaluate(u),
+                                                                        Ct = instance.C_in_Lagrange_basis.evaluate(u);
 
-                            for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
-                                At[i] += u[extra_constr_offset + 2 * i - 1];
-                                At[0] += u[extra_constr_offset + 2 * i - 1];
-                                Ct[i] += times_four(u[extra_constr_offset + 2 * i - 1]);
-                                Ct[extra_var_offset2 + i] += u[extra_constr_offset + 2 * i - 1];
-
-                                At[i] += u[extra_constr_offset + 2 * i];
-                                At[0] -= u[extra_constr_offset + 2 * i];
-                                Ct[extra_var_offset2 + i] += u[extra_constr_offset + 2 * i];
-                            }
-
-                            typename FieldType::value_type ti = FieldType::value_type::one();
-                            for (std::size_t i = 0; i < domain->m + 1; ++i) {
-                                Ht.emplace_back(ti);
-                                ti *= t;
-                            }
+                            std::vector<typename FieldType::value_type> Ht =
+                                detail::powers<FieldType>(t, domain->m + 1);
 
                             return sap_instance_evaluation<FieldType>(domain,
-                                                                      sap_num_variables,
+                                                                      instance.num_variables,
                                                                       domain->m,
                                                                       cs.num_inputs(),
                                                                       t,
@@ -315,157 +329,141 @@ namespace nil {
                                         const r1cs_auxiliary_input<FieldType> &auxiliary_input,
                                         const typename FieldType::value_type &d1,
                                         const typename FieldType::value_type &d2) {
+                            workspace_type workspace(cs);
+                            witness_map(cs, primary_input, auxiliary_input, d1, d2, workspace);
+
+                            return std::move(workspace.witness);
+                        }
+
+                        /**
+                         * Witness map reusing the buffers of the workspace, which must have been created for cs.
+                         * The returned witness is owned by the workspace and is overwritten by the next call.
+                         */
+                        static const sap_witness<FieldType> &
+                            witness_map(const r1cs_constraint_system<FieldType> &cs,
+                                        const r1cs_primary_input<FieldType> &primary_input,
+                                        const r1cs_auxiliary_input<FieldType> &auxiliary_input,
+                                        const typename FieldType::value_type &d1,
+                                        const typename FieldType::value_type &d2,
+                                        workspace_type &workspace) {
                             /* sanity check */
                             assert(cs.is_satisfied(primary_input, auxiliary_input));
 
-                            const std::shared_ptr<math::evaluation_domain<FieldType>> domain = get_domain(cs);
+                            const std::shared_ptr<math::evaluation_domain<FieldType>> &domain = workspace.domain;
+                            assert(domain->m >= 2 * cs.num_constraints() + 2 * cs.num_inputs() + 1);
 
-                            std::size_t sap_num_variables = cs.num_variables() + cs.num_constraints() + cs.num_inputs();
+                            sap_witness<FieldType> &witness = workspace.witness;
+                            witness.num_variables = cs.num_variables() + cs.num_constraints() + cs.num_inputs();
+                            witness.degree = domain->m;
+                            witness.num_inputs = cs.num_inputs();
+                            witness.d1 = d1;
+                            witness.d2 = d2;
 
-                            r1cs_variable_assignment<FieldType> full_variable_assignment = primary_input;
+                            r1cs_variable_assignment<FieldType> &full_variable_assignment =
+                                witness.coefficients_for_ACs;
+                            full_variable_assignment.assign(primary_input.begin(), primary_input.end());
                             full_variable_assignment.insert(
                                 full_variable_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
+                            full_variable_assignment.resize(witness.num_variables);
+
+                            std::vector<typename FieldType::value_type> &aA = workspace.aA, &aC = workspace.aC;
+                            aA.assign(domain->m, FieldType::value_type::zero());
+                            aC.assign(domain->m, FieldType::value_type::zero());
+
                             /**
-                             * we need to generate values of all the extra variables that we added
-                             * during the reduction
-                             *
-                             * note: below, we pass full_variable_assignment into the .evaluate()
-                             * method of the R1CS constraints. however, these extra variables shouldn't
-                             * be a problem, because .evaluate() only accesses the variables that are
-                             * actually used in the constraint.
+                             * Every constraint is evaluated once, filling its two rows of aA and aC (as in
+                             * instance_map) and the extra variable (extra_var_offset + i) we introduced for it,
+                             * whose value is (a - b)^2. Constraints write disjoint rows and variables, and
+                             * .evaluate() only reads the original variables, so they are processed in parallel.
                              */
+                            const std::size_t extra_var_offset = cs.num_variables() + 1;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                /**
-                                 * this is variable (extra_var_offset + i), an extra variable
-                                 * we introduced that is not present in the input.
-                                 * its value is (a - b)^2
-                                 */
-                                typename FieldType::value_type extra_var =
-                                    cs.constraints[i].a.evaluate(full_variable_assignment) -
-                                    cs.constraints[i].b.evaluate(full_variable_assignment);
-                                extra_var = extra_var * extra_var;
-                                full_variable_assignment.push_back(extra_var);
-                            }
-                            for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
-                                /**
-                                 * this is variable (extra_var_offset2 + i), an extra variable
-                                 * we introduced that is not present in the input.
-                                 * its value is (x_i - 1)^2
-                                 */
-                                typename FieldType::value_type extra_var =
-                                    full_variable_assignment[i - 1] - FieldType::value_type::one();
-                                extra_var = extra_var * extra_var;
-                                full_variable_assignment.push_back(extra_var);
+                                const typename FieldType::value_type
+                                    a = cs.constraints[i].a.evaluate(full_variable_assignment),
+                                    b = cs.constraints[i].b.evaluate(full_variable_assignment),
+                                    c = cs.constraints[i].c.evaluate(full_variable_assignment);
+                                const typename FieldType::value_type extra_var = (a - b).squared();
+                                full_variable_assignment[extra_var_offset + i - 1] = extra_var;
+
+                                aA[2 * i] = a + b;
+                                aA[2 * i + 1] = a - b;
+
+                                aC[2 * i] = times_four(c) + extra_var;
+                                aC[2 * i + 1] = extra_var;
                             }
 
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero());
-
-                            /* account for all constraints, as in instance_map */
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[2 * i] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aA[2 * i] += cs.constraints[i].b.evaluate(full_variable_assignment);
-
-                                aA[2 * i + 1] += cs.constraints[i].a.evaluate(full_variable_assignment);
-                                aA[2 * i + 1] -= cs.constraints[i].b.evaluate(full_variable_assignment);
-                            }
-
-                            std::size_t extra_constr_offset = 2 * cs.num_constraints();
-
-                            aA[extra_constr_offset] += FieldType::value_type::one();
+                            /* the extra constraints for the inputs, and their extra variables
+                             * (extra_var_offset2 + i) of value (x_i - 1)^2 */
+                            const std::size_t extra_constr_offset = 2 * cs.num_constraints();
+                            const std::size_t extra_var_offset2 = cs.num_variables() + cs.num_constraints();
 
+                            aA[extra_constr_offset] = FieldType::value_type::one();
+                            aC[extra_constr_offset] = FieldType::value_type::one();
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
-                                aA[extra_constr_offset + 2 * i - 1] += full_variable_assignment[i - 1];
-                                aA[extra_constr_offset + 2 * i - 1] += FieldType::value_type::one();
+                                const typename FieldType::value_type &x = full_variable_assignment[i - 1];
+                                const typename FieldType::value_type extra_var =
+                                    (x - FieldType::value_type::one()).squared();
+                                full_variable_assignment[extra_var_offset2 + i - 1] = extra_var;
+
+                                aA[extra_constr_offset + 2 * i - 1] = x + FieldType::value_type::one();
+                                aA[extra_constr_offset + 2 * i] = x - FieldType::value_type::one();
 
-                                aA[extra_constr_offset + 2 * i] += full_variable_assignment[i - 1];
-                                aA[extra_constr_offset + 2 * i] -= FieldType::value_type::one();
+                                aC[extra_constr_offset + 2 * i - 1] = times_four(x) + extra_var;
+                                aC[extra_constr_offset + 2 * i] = extra_var;
                             }
 
                             domain->inverse_fft(aA);
 
-                            std::vector<typename FieldType::value_type> coefficients_for_H(
-                                domain->m + 1, FieldType::value_type::zero());
+                            const detail::coset_table<FieldType> &coset = workspace.coset;
+                            std::vector<typename FieldType::value_type> &coefficients_for_H =
+                                witness.coefficients_for_H;
+                            coefficients_for_H.assign(domain->m + 1, FieldType::value_type::zero());
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
-                            /* add coefficients of the polynomial (2*d1*A - d2) + d1*d1*Z */
+                            /* add coefficients of the polynomial (2*d1*A - d2) + d1*d1*Z, and move A to the
+                             * coset g*S in the same pass */
                             for (std::size_t i = 0; i < domain->m; ++i) {
                                 coefficients_for_H[i] = (d1 * aA[i]) + (d1 * aA[i]);
+                                aA[i] *= coset.powers[i];
                             }
                             coefficients_for_H[0] -= d2;
                             domain->add_poly_z(d1 * d1, coefficients_for_H);
 
-                            math::multiply_by_coset(aA,
-                                                   typename FieldType::value_type(
-                                                       fields::arithmetic_params<FieldType>::multiplicative_generator));
                             domain->fft(aA);
 
-                            std::vector<typename FieldType::value_type> &H_tmp =
-                                aA;    // can overwrite aA because it is not used later
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-                            for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = aA[i] * aA[i];
-                            }
-
-                            std::vector<typename FieldType::value_type> aC(domain->m, FieldType::value_type::zero());
-                            /* again, accounting for all constraints */
-                            std::size_t extra_var_offset = cs.num_variables() + 1;
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aC[2 * i] += times_four(cs.constraints[i].c.evaluate(full_variable_assignment));
-
-                                aC[2 * i] += full_variable_assignment[extra_var_offset + i - 1];
-                                aC[2 * i + 1] += full_variable_assignment[extra_var_offset + i - 1];
-                            }
-
-                            std::size_t extra_var_offset2 = cs.num_variables() + cs.num_constraints();
-                            aC[extra_constr_offset] += FieldType::value_type::one();
-
-                            for (std::size_t i = 1; i <= cs.num_inputs(); ++i) {
-                                aC[extra_constr_offset + 2 * i - 1] += times_four(full_variable_assignment[i - 1]);
-
-                                aC[extra_constr_offset + 2 * i - 1] +=
-                                    full_variable_assignment[extra_var_offset2 + i - 1];
-                                aC[extra_constr_offset + 2 * i] += full_variable_assignment[extra_var_offset2 + i - 1];
-                            }
-
                             domain->inverse_fft(aC);
 
-                            math::multiply_by_coset(aC,
-                                                   typename FieldType::value_type(
-                                                       fields::arithmetic_params<FieldType>::multiplicative_generator));
-                            domain->fft(aC);
+                            detail::coset_fft(domain, aC, coset);
 
+                            std::vector<typename FieldType::value_type> &H_tmp =
+                                aA;    // can overwrite aA because it is not used later
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
                             for (std::size_t i = 0; i < domain->m; ++i) {
-                                H_tmp[i] = (H_tmp[i] - aC[i]);
+                                H_tmp[i] = aA[i] * aA[i] - aC[i];
                             }
 
                             domain->divide_by_z_on_coset(H_tmp);
 
                             domain->inverse_fft(H_tmp);
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                  fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                  .inversed());
 
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
+                            /* move H back from the coset while accumulating it */
                             for (std::size_t i = 0; i < domain->m; ++i) {
-                                coefficients_for_H[i] += H_tmp[i];
+                                coefficients_for_H[i] += H_tmp[i] * coset.inverse_powers[i];
                             }
 
-                            return sap_witness<FieldType>(sap_num_variables,
-                                                          domain->m,
-                                                          cs.num_inputs(),
-                                                          d1,
-                                                          d2,
-                                                          full_variable_assignment,
-                                                          std::move(coefficients_for_H));
+                            return witness;
                         }
                     };
                 }    // namespace reductions
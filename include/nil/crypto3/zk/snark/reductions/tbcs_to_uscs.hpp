@@ -47,6 +47,7 @@
 
 #include <nil/crypto3/zk/snark/relations/circuit_satisfaction_problems/tbcs.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/uscs.hpp>
+#include <nil/crypto3/zk/snark/reductions/uscs_to_ssp.hpp>
 
 namespace nil {
     namespace crypto3 {
@@ -190,6 +191,39 @@ namespace nil {
                                 algebra::convert_bit_vector_to_field_element_vector<FieldType>(all_wires);
                             return result;
                         }
+
+                        /**
+                         * Same as above, writing the field assignment straight into the SSP witness of workspace
+                         * while the gates are evaluated, instead of building it from a separate bit vector. Follow
+                         * with uscs_to_ssp::witness_map_from_assignment().
+                         */
+                        static void witness_map(const tbcs_circuit &circuit,
+                                                const tbcs_primary_input &primary_input,
+                                                const tbcs_auxiliary_input &auxiliary_input,
+                                                typename uscs_to_ssp<FieldType>::workspace_type &workspace) {
+                            assert(primary_input.size() == circuit.primary_input_size);
+                            assert(auxiliary_input.size() == circuit.auxiliary_input_size);
+
+                            const typename FieldType::value_type one = FieldType::value_type::one(),
+                                                                 zero = FieldType::value_type::zero();
+
+                            tbcs_variable_assignment wires;
+                            wires.reserve(circuit.num_wires());
+                            wires.insert(wires.end(), primary_input.begin(), primary_input.end());
+                            wires.insert(wires.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+                            uscs_variable_assignment<FieldType> &result = workspace.witness.coefficients_for_Vs;
+                            result.resize(circuit.num_wires());
+                            for (std::size_t i = 0; i < wires.size(); ++i) {
+                                result[i] = wires[i] ? one : zero;
+                            }
+
+                            for (auto &g : circuit.gates) {
+                                const bool gate_output = g.evaluate(wires);
+                                result[wires.size()] = gate_output ? one : zero;
+                                wires.push_back(gate_output);
+                            }
+                        }
                     };
                 }    // namespace reductions
             }        // namespace snark
@@ -48,9 +48,12 @@
 #ifndef CRYPTO3_ZK_USCS_TO_SSP_REDUCTION_HPP
 #define CRYPTO3_ZK_USCS_TO_SSP_REDUCTION_HPP
 
-#include <nil/crypto3/math/coset.hpp>
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
+#include <nil/crypto3/math/algorithms/make_evaluation_domain.hpp>
 
+#include <nil/crypto3/zk/snark/reductions/detail/coset.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/domain_selection.hpp>
+#include <nil/crypto3/zk/snark/reductions/detail/powers.hpp>
 #include <nil/crypto3/zk/snark/relations/arithmetic_programs/ssp.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/uscs.hpp>
 
@@ -63,6 +66,51 @@ namespace nil {
                     struct uscs_to_ssp {
                         typedef FieldType field_type;
 
+                        /**
+                         * The evaluation domain type and size that will be used by the reduction for a given USCS
+                         * instance: the cheapest one, under detail::domain_selection's cost model, for the three
+                         * FFTs of witness_map() and the H query multi-exponentiation.
+                         */
+                        static detail::domain_choice get_domain_choice(const uscs_constraint_system<FieldType> &cs) {
+                            return detail::domain_selection<FieldType>::select(cs.num_constraints(), 3);
+                        }
+
+                        /**
+                         * Helper function to find evaluation domain that will be used by the reduction
+                         * for a given USCS instance.
+                         */
+                        static std::shared_ptr<evaluation_domain<FieldType>>
+                            get_domain(const uscs_constraint_system<FieldType> &cs) {
+                            return detail::domain_selection<FieldType>::make_domain(get_domain_choice(cs));
+                        }
+
+                        /**
+                         * Buffers of the witness map for a given USCS instance.
+                         *
+                         * A workspace is created once per constraint system and passed to every witness_map()
+                         * call; the evaluation domain, its coset power tables, the evaluation vector and the
+                         * resulting witness keep their storage between calls, so steady-state proving does not
+                         * allocate.
+                         */
+                        struct workspace_type {
+                            explicit workspace_type(const uscs_constraint_system<FieldType> &cs) :
+                                domain(get_domain(cs)), coset(domain->m),
+                                witness(cs.num_variables(), domain->m, cs.num_inputs(), FieldType::value_type::zero(),
+                                        std::vector<typename FieldType::value_type>(),
+                                        std::vector<typename FieldType::value_type>()) {
+                                aA.reserve(domain->m);
+                                witness.coefficients_for_Vs.reserve(cs.num_variables());
+                                witness.coefficients_for_H.reserve(domain->m + 1);
+                            }
+
+                            std::shared_ptr<evaluation_domain<FieldType>> domain;
+                            detail::coset_table<FieldType> coset;
+
+                            std::vector<typename FieldType::value_type> aA;
+
+                            ssp_witness<FieldType> witness;
+                        };
+
                         /**
                          * Instance map for the USCS-to-SSP reduction.
                          *
@@ -74,22 +122,37 @@ namespace nil {
                          *   each V_i is expressed in the Lagrange basis.
                          */
                         static ssp_instance<FieldType> instance_map(const uscs_constraint_system<FieldType> &cs) {
-                            const std::shared_ptr<evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints());
-                            std::vector<std::map<std::size_t, typename FieldType::value_type>> V_in_Lagrange_basis(
-                                cs.num_variables() + 1);
+                            const std::shared_ptr<evaluation_domain<FieldType>> domain = get_domain(cs);
+                            typedef typename sparse_matrix<FieldType>::entry_type entry_type;
+
+                            /* entries of constraint i start at V_offsets[i], so constraints fill them in parallel */
+                            std::vector<std::size_t> V_offsets(cs.num_constraints() + 1, 0);
+                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
+                                V_offsets[i + 1] = V_offsets[i] + cs.constraints[i].terms.size();
+                            }
+                            const std::size_t padding_offset = V_offsets[cs.num_constraints()];
+
+                            std::vector<entry_type> V_entries(padding_offset + domain->m - cs.num_constraints());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
                                 for (std::size_t j = 0; j < cs.constraints[i].terms.size(); ++j) {
-                                    V_in_Lagrange_basis[cs.constraints[i].terms[j].index][i] +=
-                                        cs.constraints[i].terms[j].coeff;
+                                    V_entries[V_offsets[i] + j] = {cs.constraints[i].terms[j].index, i,
+                                                                   cs.constraints[i].terms[j].coeff};
                                 }
                             }
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
                             for (std::size_t i = cs.num_constraints(); i < domain->m; ++i) {
-                                V_in_Lagrange_basis[0][i] += FieldType::value_type::one();
+                                V_entries[padding_offset + i - cs.num_constraints()] = {
+                                    0, i, FieldType::value_type::one()};
                             }
 
                             return ssp_instance<FieldType>(
-                                domain, cs.num_variables(), domain->m, cs.num_inputs(), std::move(V_in_Lagrange_basis));
+                                domain, cs.num_variables(), domain->m, cs.num_inputs(),
+                                sparse_matrix<FieldType>(cs.num_variables() + 1, std::move(V_entries)));
                         }
 
                         /**
@@ -108,30 +171,19 @@ namespace nil {
                         static ssp_instance_evaluation<FieldType>
                             instance_map_with_evaluation(const uscs_constraint_system<FieldType> &cs,
                                                          const typename FieldType::value_type &t) {
-                            const std::shared_ptr<evaluation_domain<FieldType>> domain =
-                                math::make_evaluation_domain<FieldType>(cs.num_constraints());
-
-                            std::vector<typename FieldType::value_type> Vt(cs.num_variables() + 1,
-                                                                           FieldType::value_type::zero());
-                            std::vector<typename FieldType::value_type> Ht(domain->m + 1);
+                            /* build the column-major Lagrange basis coefficients once and evaluate them at t */
+                            const ssp_instance<FieldType> instance = instance_map(cs);
+                            const std::shared_ptr<evaluation_domain<FieldType>> &domain = instance.domain;
 
                             const typename FieldType::value_type Zt = domain->compute_vanishing_polynomial(t);
 
                             const std::vector<typename FieldType::value_type> u =
                                 domain->evaluate_all_lagrange_polynomials(t);
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                for (std::size_t j = 0; j < cs.constraints[i].terms.size(); ++j) {
-                                    Vt[cs.constraints[i].terms[j].index] += u[i] * cs.constraints[i].terms[j].coeff;
-                                }
-                            }
-                            for (std::size_t i = cs.num_constraints(); i < domain->m; ++i) {
-                                Vt[0] += u[i]; /* dummy constraint: 1^2 = 1 */
-                            }
-                            typename FieldType::value_type ti = FieldType::value_type::one();
-                            for (std::size_t i = 0; i < domain->m + 1; ++i) {
-                                Ht[i] = ti;
-                                ti *= t;
-                            }
+
+                            std::vector<typename FieldType::value_type> Vt = instance.V_in_Lagrange_basis.evaluate(u);
+
+                            std::vector<typename FieldType::value_type> Ht =
+                                detail::powers<FieldType>(t, domain->m + 1);
 
                             return ssp_instance_evaluation<FieldType>(domain,
                                                                       cs.num_variables(),
@@ -175,43 +227,85 @@ namespace nil {
                                         const uscs_primary_input<FieldType> &primary_input,
                                         const uscs_auxiliary_input<FieldType> &auxiliary_input,
                                         const typename FieldType::value_type &d) {
+                            workspace_type workspace(cs);
+                            witness_map(cs, primary_input, auxiliary_input, d, workspace);
+
+                            return std::move(workspace.witness);
+                        }
+
+                        /**
+                         * Witness map reusing the buffers of the workspace, which must have been created for cs.
+                         * The returned witness is owned by the workspace and is overwritten by the next call.
+                         */
+                        static const ssp_witness<FieldType> &
+                            witness_map(const uscs_constraint_system<FieldType> &cs,
+                                        const uscs_primary_input<FieldType> &primary_input,
+                                        const uscs_auxiliary_input<FieldType> &auxiliary_input,
+                                        const typename FieldType::value_type &d,
+                                        workspace_type &workspace) {
                             /* sanity check */
 
                             assert(cs.is_satisfied(primary_input, auxiliary_input));
 
-                            uscs_variable_assignment<FieldType> full_variable_assignment = primary_input;
+                            uscs_variable_assignment<FieldType> &full_variable_assignment =
+                                workspace.witness.coefficients_for_Vs;
+                            full_variable_assignment.assign(primary_input.begin(), primary_input.end());
                             full_variable_assignment.insert(
                                 full_variable_assignment.end(), auxiliary_input.begin(), auxiliary_input.end());
 
-                            const std::shared_ptr<evaluation_domain<FieldType>> domain =
-                                make_evaluation_domain<FieldType>(cs.num_constraints());
+                            return witness_map_from_assignment(cs, d, workspace);
+                        }
 
-                            std::vector<typename FieldType::value_type> aA(domain->m, FieldType::value_type::zero());
+                        /**
+                         * Second half of witness_map(), for callers that build the full variable assignment
+                         * themselves, such as the circuit reductions: workspace.witness.coefficients_for_Vs must
+                         * hold it.
+                         */
+                        static const ssp_witness<FieldType> &
+                            witness_map_from_assignment(const uscs_constraint_system<FieldType> &cs,
+                                                        const typename FieldType::value_type &d,
+                                                        workspace_type &workspace) {
+                            const std::shared_ptr<evaluation_domain<FieldType>> &domain = workspace.domain;
                             assert(domain->m >= cs.num_constraints());
-                            for (std::size_t i = 0; i < cs.num_constraints(); ++i) {
-                                aA[i] += cs.constraints[i].evaluate(full_variable_assignment);
-                            }
-                            for (std::size_t i = cs.num_constraints(); i < domain->m; ++i) {
-                                aA[i] += FieldType::value_type::one();
+
+                            ssp_witness<FieldType> &witness = workspace.witness;
+                            assert(witness.coefficients_for_Vs.size() == cs.num_variables());
+                            witness.num_variables = cs.num_variables();
+                            witness.degree = domain->m;
+                            witness.num_inputs = cs.num_inputs();
+                            witness.d = d;
+
+                            const uscs_variable_assignment<FieldType> &full_variable_assignment =
+                                witness.coefficients_for_Vs;
+
+                            std::vector<typename FieldType::value_type> &aA = workspace.aA;
+                            aA.resize(domain->m);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                            for (std::size_t i = 0; i < domain->m; ++i) {
+                                aA[i] = (i < cs.num_constraints()) ?
+                                            cs.constraints[i].evaluate(full_variable_assignment) :
+                                            FieldType::value_type::one();
                             }
 
                             domain->inverse_fft(aA);
 
-                            std::vector<typename FieldType::value_type> coefficients_for_H(
-                                domain->m + 1, FieldType::value_type::zero());
+                            const detail::coset_table<FieldType> &coset = workspace.coset;
+                            std::vector<typename FieldType::value_type> &coefficients_for_H =
+                                witness.coefficients_for_H;
+                            coefficients_for_H.assign(domain->m + 1, FieldType::value_type::zero());
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
-                            /* add coefficients of the polynomial 2*d*V(z) + d*d*Z(z) */
+                            /* add coefficients of the polynomial 2*d*V(z) + d*d*Z(z), and move V to the coset g*S
+                             * in the same pass */
                             for (std::size_t i = 0; i < domain->m; ++i) {
                                 coefficients_for_H[i] = typename FieldType::value_type(2) * d * aA[i];
+                                aA[i] *= coset.powers[i];
                             }
                             domain->add_poly_z(d.squared(), coefficients_for_H);
 
-                            math::multiply_by_coset(
-                                aA,
-                                typename FieldType::value_type(
-                                    fields::arithmetic_params<FieldType>::multiplicative_generator));
                             domain->fft(aA);
 
                             std::vector<typename FieldType::value_type> &H_tmp =
@@ -226,24 +320,16 @@ namespace nil {
                             domain->divide_by_z_on_coset(H_tmp);
 
                             domain->inverse_fft(H_tmp);
-                            multiply_by_coset(H_tmp,
-                                              typename FieldType::value_type(
-                                                  fields::arithmetic_params<FieldType>::multiplicative_generator)
-                                                  .inversed());
 
 #ifdef MULTICORE
 #pragma omp parallel for
 #endif
+                            /* move H back from the coset while accumulating it */
                             for (std::size_t i = 0; i < domain->m; ++i) {
-                                coefficients_for_H[i] += H_tmp[i];
+                                coefficients_for_H[i] += H_tmp[i] * coset.inverse_powers[i];
                             }
 
-                            return ssp_witness<FieldType>(cs.num_variables(),
-                                                          domain->m,
-                                                          cs.num_inputs(),
-                                                          d,
-                                                          full_variable_assignment,
-                                                          std::move(coefficients_for_H));
+                            return witness;
                         }
                     };
                 }    // namespace reductions
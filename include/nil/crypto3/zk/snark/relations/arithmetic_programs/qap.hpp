@@ -38,7 +38,6 @@
 #ifndef CRYPTO3_ZK_QAP_HPP
 #define CRYPTO3_ZK_QAP_HPP
 
-#include <map>
 #include <vector>
 
 #include <nil/crypto3/algebra/random_element.hpp>
@@ -46,6 +45,8 @@
 
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
+#include <nil/crypto3/zk/snark/sparse_matrix.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -67,7 +68,7 @@ namespace nil {
                  * Specifically, the data structure stores:
                  * - a choice of domain (corresponding to a certain subset of the field);
                  * - the number of variables, the degree, and the number of inputs; and
-                 * - coefficients of the A,B,C polynomials in the Lagrange basis.
+                 * - coefficients of the A,B,C polynomials in the Lagrange basis, one sparse column per polynomial.
                  *
                  * There is no need to store the Z polynomial because it is uniquely
                  * determined by the domain (as Z is its vanishing polynomial).
@@ -84,17 +85,17 @@ namespace nil {
 
                     std::shared_ptr<evaluation_domain<field_type>> domain;
 
-                    std::vector<std::map<std::size_t, field_value_type>> A_in_Lagrange_basis;
-                    std::vector<std::map<std::size_t, field_value_type>> B_in_Lagrange_basis;
-                    std::vector<std::map<std::size_t, field_value_type>> C_in_Lagrange_basis;
+                    sparse_matrix<field_type> A_in_Lagrange_basis;
+                    sparse_matrix<field_type> B_in_Lagrange_basis;
+                    sparse_matrix<field_type> C_in_Lagrange_basis;
 
                     qap_instance(const std::shared_ptr<evaluation_domain<field_type>> &domain,
                                  const std::size_t num_variables,
                                  const std::size_t degree,
                                  const std::size_t num_inputs,
-                                 const std::vector<std::map<std::size_t, field_value_type>> &A_in_Lagrange_basis,
-                                 const std::vector<std::map<std::size_t, field_value_type>> &B_in_Lagrange_basis,
-                                 const std::vector<std::map<std::size_t, field_value_type>> &C_in_Lagrange_basis) :
+                                 const sparse_matrix<field_type> &A_in_Lagrange_basis,
+                                 const sparse_matrix<field_type> &B_in_Lagrange_basis,
+                                 const sparse_matrix<field_type> &C_in_Lagrange_basis) :
                         num_variables(num_variables),
                         degree(degree), num_inputs(num_inputs), domain(domain),
                         A_in_Lagrange_basis(A_in_Lagrange_basis), B_in_Lagrange_basis(B_in_Lagrange_basis),
@@ -105,9 +106,9 @@ namespace nil {
                                  const std::size_t num_variables,
                                  const std::size_t degree,
                                  const std::size_t num_inputs,
-                                 std::vector<std::map<std::size_t, field_value_type>> &&A_in_Lagrange_basis,
-                                 std::vector<std::map<std::size_t, field_value_type>> &&B_in_Lagrange_basis,
-                                 std::vector<std::map<std::size_t, field_value_type>> &&C_in_Lagrange_basis) :
+                                 sparse_matrix<field_type> &&A_in_Lagrange_basis,
+                                 sparse_matrix<field_type> &&B_in_Lagrange_basis,
+                                 sparse_matrix<field_type> &&C_in_Lagrange_basis) :
                         num_variables(num_variables),
                         degree(degree), num_inputs(num_inputs), domain(domain),
                         A_in_Lagrange_basis(std::move(A_in_Lagrange_basis)),
@@ -123,28 +124,15 @@ namespace nil {
                     bool is_satisfied(const qap_witness<field_type> &witness) const {
                         const field_value_type t = algebra::random_element<field_type>();
 
-                        std::vector<field_value_type> At(this->num_variables + 1, field_value_type::zero());
-                        std::vector<field_value_type> Bt(this->num_variables + 1, field_value_type::zero());
-                        std::vector<field_value_type> Ct(this->num_variables + 1, field_value_type::zero());
                         std::vector<field_value_type> Ht(this->degree + 1);
 
                         const field_value_type Zt = this->domain->compute_vanishing_polynomial(t);
 
                         const std::vector<field_value_type> u = this->domain->evaluate_all_lagrange_polynomials(t);
 
-                        for (size_t i = 0; i < this->num_variables + 1; ++i) {
-                            for (auto &el : A_in_Lagrange_basis[i]) {
-                                At[i] += u[el.first] * el.second;
-                            }
-
-                            for (auto &el : B_in_Lagrange_basis[i]) {
-                                Bt[i] += u[el.first] * el.second;
-                            }
-
-                            for (auto &el : C_in_Lagrange_basis[i]) {
-                                Ct[i] += u[el.first] * el.second;
-                            }
-                        }
+                        std::vector<field_value_type> At = A_in_Lagrange_basis.evaluate(u);
+                        std::vector<field_value_type> Bt = B_in_Lagrange_basis.evaluate(u);
+                        std::vector<field_value_type> Ct = C_in_Lagrange_basis.evaluate(u);
 
                         field_value_type ti = field_value_type::one();
                         for (size_t i = 0; i < this->degree + 1; ++i) {
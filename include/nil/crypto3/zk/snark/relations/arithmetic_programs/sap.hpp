@@ -39,7 +39,6 @@
 #ifndef CRYPTO3_ZK_SAP_HPP
 #define CRYPTO3_ZK_SAP_HPP
 
-#include <map>
 #include <vector>
 
 #include <nil/crypto3/algebra/random_element.hpp>
@@ -47,6 +46,8 @@
 
 #include <nil/crypto3/math/domains/evaluation_domain.hpp>
 
+#include <nil/crypto3/zk/snark/sparse_matrix.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -68,7 +69,7 @@ namespace nil {
                  * Specifically, the datastructure stores:
                  * - a choice of domain (corresponding to a certain subset of the field);
                  * - the number of variables, the degree, and the number of inputs; and
-                 * - coefficients of the A,C polynomials in the Lagrange basis.
+                 * - coefficients of the A,C polynomials in the Lagrange basis, one sparse column per polynomial.
                  *
                  * There is no need to store the Z polynomial because it is uniquely
                  * determined by the domain (as Z is its vanishing polynomial).
@@ -81,16 +82,16 @@ namespace nil {
 
                     std::shared_ptr<evaluation_domain<FieldType>> domain;
 
-                    std::vector<std::map<std::size_t, typename FieldType::value_type>> A_in_Lagrange_basis;
-                    std::vector<std::map<std::size_t, typename FieldType::value_type>> C_in_Lagrange_basis;
+                    sparse_matrix<FieldType> A_in_Lagrange_basis;
+                    sparse_matrix<FieldType> C_in_Lagrange_basis;
 
                     sap_instance(
                         const std::shared_ptr<evaluation_domain<FieldType>> &domain,
                         const std::size_t num_variables,
                         const std::size_t degree,
                         const std::size_t num_inputs,
-                        const std::vector<std::map<std::size_t, typename FieldType::value_type>> &A_in_Lagrange_basis,
-                        const std::vector<std::map<std::size_t, typename FieldType::value_type>> &C_in_Lagrange_basis) :
+                        const sparse_matrix<FieldType> &A_in_Lagrange_basis,
+                        const sparse_matrix<FieldType> &C_in_Lagrange_basis) :
                         num_variables(num_variables),
                         degree(degree), num_inputs(num_inputs), domain(domain),
                         A_in_Lagrange_basis(A_in_Lagrange_basis), C_in_Lagrange_basis(C_in_Lagrange_basis) {
@@ -101,8 +102,8 @@ namespace nil {
                         const std::size_t num_variables,
                         const std::size_t degree,
                         const std::size_t num_inputs,
-                        std::vector<std::map<std::size_t, typename FieldType::value_type>> &&A_in_Lagrange_basis,
-                        std::vector<std::map<std::size_t, typename FieldType::value_type>> &&C_in_Lagrange_basis) :
+                        sparse_matrix<FieldType> &&A_in_Lagrange_basis,
+                        sparse_matrix<FieldType> &&C_in_Lagrange_basis) :
                         num_variables(num_variables),
                         degree(degree), num_inputs(num_inputs), domain(domain),
                         A_in_Lagrange_basis(std::move(A_in_Lagrange_basis)),
@@ -117,10 +118,6 @@ namespace nil {
                     bool is_satisfied(const sap_witness<FieldType> &witness) const {
                         const typename FieldType::value_type t = algebra::random_element<FieldType>();
 
-                        std::vector<typename FieldType::value_type> At(this->num_variables + 1,
-                                                                       FieldType::value_type::zero());
-                        std::vector<typename FieldType::value_type> Ct(this->num_variables + 1,
-                                                                       FieldType::value_type::zero());
                         std::vector<typename FieldType::value_type> Ht(this->degree + 1);
 
                         const typename FieldType::value_type Zt = this->domain->compute_vanishing_polynomial(t);
@@ -128,15 +125,8 @@ namespace nil {
                         const std::vector<typename FieldType::value_type> u =
                             this->domain->evaluate_all_lagrange_polynomials(t);
 
-                        for (std::size_t i = 0; i < this->num_variables + 1; ++i) {
-                            for (auto &el : A_in_Lagrange_basis[i]) {
-                                At[i] += u[el.first] * el.second;
-                            }
-
-                            for (auto &el : C_in_Lagrange_basis[i]) {
-                                Ct[i] += u[el.first] * el.second;
-                            }
-                        }
+                        std::vector<typename FieldType::value_type> At = A_in_Lagrange_basis.evaluate(u);
+                        std::vector<typename FieldType::value_type> Ct = C_in_Lagrange_basis.evaluate(u);
 
                         typename FieldType::value_type ti = FieldType::value_type::one();
                         for (std::size_t i = 0; i < this->degree + 1; ++i) {
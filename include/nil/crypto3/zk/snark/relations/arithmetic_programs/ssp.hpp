@@ -38,13 +38,15 @@
 #ifndef CRYPTO3_ZK_SSP_HPP
 #define CRYPTO3_ZK_SSP_HPP
 
-#include <map>
+#include <vector>
 
 #include <nil/crypto3/algebra/multiexp/inner_product.hpp>
 #include <nil/crypto3/algebra/random_element.hpp>
 
 #include <nil/crypto3/math/evaluation_domain.hpp>
 
+#include <nil/crypto3/zk/snark/sparse_matrix.hpp>
+
 namespace nil {
     namespace crypto3 {
         namespace zk {
@@ -66,7 +68,7 @@ namespace nil {
                  * Specifically, the datastructure stores:
                  * - a choice of domain (corresponding to a certain subset of the field);
                  * - the number of variables, the degree, and the number of inputs; and
-                 * - coefficients of the V polynomials in the Lagrange basis.
+                 * - coefficients of the V polynomials in the Lagrange basis, one sparse column per polynomial.
                  *
                  * There is no need to store the Z polynomial because it is uniquely
                  * determined by the domain (as Z is its vanishing polynomial).
@@ -79,14 +81,14 @@ namespace nil {
 
                     std::shared_ptr<evaluation_domain<FieldType>> domain;
 
-                    std::vector<std::map<std::size_t, typename FieldType::value_type>> V_in_Lagrange_basis;
+                    sparse_matrix<FieldType> V_in_Lagrange_basis;
 
                     ssp_instance(
                         const std::shared_ptr<evaluation_domain<FieldType>> &domain,
                         const std::size_t num_variables,
                         const std::size_t degree,
                         const std::size_t num_inputs,
-                        const std::vector<std::map<std::size_t, typename FieldType::value_type>> &V_in_Lagrange_basis) :
+                        const sparse_matrix<FieldType> &V_in_Lagrange_basis) :
                         num_variables(num_variables),
                         degree(degree), num_inputs(num_inputs), domain(domain),
                         V_in_Lagrange_basis(V_in_Lagrange_basis) {
@@ -97,7 +99,7 @@ namespace nil {
                         const std::size_t num_variables,
                         const std::size_t degree,
                         const std::size_t num_inputs,
-                        std::vector<std::map<std::size_t, typename FieldType::value_type>> &&V_in_Lagrange_basis) :
+                        sparse_matrix<FieldType> &&V_in_Lagrange_basis) :
                         num_variables(num_variables),
                         degree(degree), num_inputs(num_inputs), domain(domain),
                         V_in_Lagrange_basis(std::move(V_in_Lagrange_basis)) {
@@ -110,8 +112,6 @@ namespace nil {
 
                     bool is_satisfied(const ssp_witness<FieldType> &witness) const {
                         const typename FieldType::value_type t = algebra::random_element<FieldType>();
-                        std::vector<typename FieldType::value_type> Vt(this->num_variables + 1,
-                                                                       FieldType::value_type::zero());
                         std::vector<typename FieldType::value_type> Ht(this->degree + 1);
 
                         const typename FieldType::value_type Zt = this->domain->compute_vanishing_polynomial(t);
@@ -119,11 +119,7 @@ namespace nil {
                         const std::vector<typename FieldType::value_type> u =
                             this->domain->evaluate_all_lagrange_polynomials(t);
 
-                        for (std::size_t i = 0; i < this->num_variables + 1; ++i) {
-                            for (auto &el : V_in_Lagrange_basis[i]) {
-                                Vt[i] += u[el.first] * el.second;
-                            }
-                        }
+                        std::vector<typename FieldType::value_type> Vt = V_in_Lagrange_basis.evaluate(u);
 
                         typename FieldType::value_type ti = FieldType::value_type::one();
                         for (std::size_t i = 0; i < this->degree + 1; ++i) {
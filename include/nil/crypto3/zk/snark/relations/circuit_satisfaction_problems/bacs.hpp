@@ -27,6 +27,7 @@
 // - a BACS gate,
 // - a BACS primary input,
 // - a BACS auxiliary input,
+// - a BACS levelized circuit,
 // - a BACS circuit.
 //
 // Above, BACS stands for "Bilinear Arithmetic Circuit Satisfiability".
@@ -35,6 +36,11 @@
 #ifndef CRYPTO3_ZK_BACS_HPP
 #define CRYPTO3_ZK_BACS_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
 #include <vector>
 
 #include <nil/crypto3/zk/snark/relations/variable.hpp>
@@ -94,6 +100,200 @@ namespace nil {
                 template<typename FieldType>
                 using bacs_auxiliary_input = bacs_variable_assignment<FieldType>;
 
+                /********************** BACS levelized circuit ******************************/
+
+                /**
+                 * A BACS circuit compiled for evaluation.
+                 *
+                 * Gates are grouped by level, the level of a gate being one more than the highest level of the
+                 * gates it reads (inputs are at level 0), and the terms of their linear combinations are stored
+                 * in flat arrays in level order. The gates of one level only read wires of lower levels, so
+                 * levels of at least min_parallel_level_width gates are evaluated in parallel; narrower ones
+                 * are evaluated serially, as they do not amortize the cost of a parallel region.
+                 *
+                 * Wire indices follow the BACS circuit: wire 0 is the constant 1, and the assignment holds the
+                 * primary input, the auxiliary input, then the gate outputs in gate order.
+                 */
+                template<typename FieldType>
+                struct bacs_levelized_circuit {
+                    typedef FieldType field_type;
+                    typedef typename FieldType::value_type field_value_type;
+
+                    /* minimal number of gates of a level for it to be evaluated in parallel */
+                    constexpr static const std::size_t min_parallel_level_width = 1024;
+
+                    bacs_levelized_circuit() : num_inputs(0) {
+                    }
+
+                    bacs_levelized_circuit(std::size_t num_inputs, const std::vector<bacs_gate<FieldType>> &gates) :
+                        num_inputs(num_inputs) {
+                        /* level of every wire, including the constant wire 0 */
+                        std::vector<std::size_t> wire_levels(1 + num_inputs + gates.size(), 0);
+                        std::vector<std::size_t> level_sizes;
+                        for (std::size_t i = 0; i < gates.size(); ++i) {
+                            std::size_t level = 0;
+                            for (const linear_combination<FieldType> *lc : {&gates[i].lhs, &gates[i].rhs}) {
+                                for (auto &t : lc->terms) {
+                                    level = std::max(level, wire_levels[t.index]);
+                                }
+                            }
+                            wire_levels[1 + num_inputs + i] = level + 1;
+
+                            if (level_sizes.size() <= level) {
+                                level_sizes.resize(level + 1, 0);
+                            }
+                            ++level_sizes[level];
+                        }
+
+                        level_offsets.resize(level_sizes.size() + 1, 0);
+                        for (std::size_t l = 0; l < level_sizes.size(); ++l) {
+                            level_offsets[l + 1] = level_offsets[l] + level_sizes[l];
+                        }
+
+                        /* stable counting sort of the gates by level */
+                        gate_indices.resize(gates.size());
+                        std::vector<std::size_t> next(level_offsets.begin(), level_offsets.end() - 1);
+                        for (std::size_t i = 0; i < gates.size(); ++i) {
+                            gate_indices[next[wire_levels[1 + num_inputs + i] - 1]++] = i;
+                        }
+
+                        term_offsets.reserve(2 * gates.size() + 1);
+                        term_offsets.emplace_back(0);
+                        for (std::size_t i : gate_indices) {
+                            for (const linear_combination<FieldType> *lc : {&gates[i].lhs, &gates[i].rhs}) {
+                                for (auto &t : lc->terms) {
+                                    term_indices.emplace_back(t.index);
+                                    term_coeffs.emplace_back(t.coeff);
+                                }
+                                term_offsets.emplace_back(term_indices.size());
+                            }
+                        }
+
+                        for (std::size_t i = 0; i < gates.size(); ++i) {
+                            if (gates[i].is_circuit_output) {
+                                output_wires.emplace_back(num_inputs + i);
+                            }
+                        }
+                    }
+
+                    std::size_t num_gates() const {
+                        return gate_indices.size();
+                    }
+
+                    std::size_t num_wires() const {
+                        return num_inputs + num_gates();
+                    }
+
+                    std::size_t num_levels() const {
+                        return level_offsets.size() - 1;
+                    }
+
+                    /**
+                     * Evaluate the gates on wires, which holds the inputs and is extended with the gate outputs.
+                     * If lhs_values and rhs_values are given, they receive the values of the two sides of every
+                     * gate, indexed by gate.
+                     */
+                    void evaluate(bacs_variable_assignment<FieldType> &wires,
+                                  std::vector<field_value_type> *lhs_values = nullptr,
+                                  std::vector<field_value_type> *rhs_values = nullptr) const {
+                        assert(wires.size() == num_inputs);
+                        wires.resize(num_wires());
+                        if (lhs_values != nullptr) {
+                            lhs_values->resize(num_gates());
+                        }
+                        if (rhs_values != nullptr) {
+                            rhs_values->resize(num_gates());
+                        }
+
+                        for (std::size_t l = 0; l + 1 < level_offsets.size(); ++l) {
+#ifdef MULTICORE
+                            const std::size_t width = level_offsets[l + 1] - level_offsets[l];
+#pragma omp parallel for if (width >= min_parallel_level_width)
+#endif
+                            for (std::size_t p = level_offsets[l]; p < level_offsets[l + 1]; ++p) {
+                                const field_value_type lhs = evaluate_terms(wires, term_offsets[2 * p],
+                                                                            term_offsets[2 * p + 1]),
+                                                       rhs = evaluate_terms(wires, term_offsets[2 * p + 1],
+                                                                            term_offsets[2 * p + 2]);
+                                const std::size_t i = gate_indices[p];
+                                wires[num_inputs + i] = lhs * rhs;
+                                if (lhs_values != nullptr) {
+                                    (*lhs_values)[i] = lhs;
+                                }
+                                if (rhs_values != nullptr) {
+                                    (*rhs_values)[i] = rhs;
+                                }
+                            }
+                        }
+                    }
+
+                    bacs_variable_assignment<FieldType>
+                        get_all_wires(const bacs_primary_input<FieldType> &primary_input,
+                                      const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        bacs_variable_assignment<FieldType> result;
+                        result.reserve(num_wires());
+                        result.insert(result.end(), primary_input.begin(), primary_input.end());
+                        result.insert(result.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+                        evaluate(result);
+
+                        return result;
+                    }
+
+                    bacs_variable_assignment<FieldType>
+                        get_all_outputs(const bacs_primary_input<FieldType> &primary_input,
+                                        const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        const bacs_variable_assignment<FieldType> all_wires =
+                            get_all_wires(primary_input, auxiliary_input);
+
+                        bacs_variable_assignment<FieldType> all_outputs;
+                        all_outputs.reserve(output_wires.size());
+                        for (std::size_t w : output_wires) {
+                            all_outputs.emplace_back(all_wires[w]);
+                        }
+
+                        return all_outputs;
+                    }
+
+                    bool is_satisfied(const bacs_primary_input<FieldType> &primary_input,
+                                      const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        const bacs_variable_assignment<FieldType> all_wires =
+                            get_all_wires(primary_input, auxiliary_input);
+
+                        for (std::size_t w : output_wires) {
+                            if (!all_wires[w].is_zero()) {
+                                return false;
+                            }
+                        }
+
+                        return true;
+                    }
+
+                    std::size_t num_inputs;
+
+                    /* gates in level order; the gates of level l are [level_offsets[l], level_offsets[l + 1]) */
+                    std::vector<std::size_t> level_offsets;
+                    std::vector<std::size_t> gate_indices;
+
+                    /* lhs of the p-th gate in level order is [term_offsets[2p], term_offsets[2p + 1]), rhs follows */
+                    std::vector<std::size_t> term_offsets;
+                    std::vector<std::size_t> term_indices;
+                    std::vector<field_value_type> term_coeffs;
+
+                    /* assignment index of every circuit output, in gate order */
+                    std::vector<std::size_t> output_wires;
+
+                private:
+                    field_value_type evaluate_terms(const bacs_variable_assignment<FieldType> &wires,
+                                                    std::size_t first, std::size_t last) const {
+                        field_value_type acc = field_value_type::zero();
+                        for (std::size_t j = first; j < last; ++j) {
+                            acc += term_indices[j] == 0 ? term_coeffs[j] : wires[term_indices[j] - 1] * term_coeffs[j];
+                        }
+                        return acc;
+                    }
+                };
+
                 /************************** BACS circuit *************************************/
 
                 /**
@@ -177,8 +377,20 @@ namespace nil {
                         return true;
                     }
 
+                    /**
+                     * The levelized form of the circuit, for callers evaluating it repeatedly or on wide levels.
+                     * get_all_wires() and is_satisfied() evaluate the gates serially in gate order instead, so
+                     * one-shot callers do not pay for building it.
+                     */
+                    bacs_levelized_circuit<FieldType> levelized() const {
+                        return bacs_levelized_circuit<FieldType>(num_inputs(), gates);
+                    }
+
                     bool is_satisfied(const bacs_primary_input<FieldType> &primary_input,
                                       const bacs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        assert(primary_input.size() == primary_input_size);
+                        assert(auxiliary_input.size() == auxiliary_input_size);
+
                         const bacs_variable_assignment<FieldType> all_outputs =
                             get_all_outputs(primary_input, auxiliary_input);
 
@@ -187,7 +399,6 @@ namespace nil {
                                 return false;
                             }
                         }
-
                         return true;
                     }
 
@@ -215,6 +426,7 @@ namespace nil {
                         assert(auxiliary_input.size() == auxiliary_input_size);
 
                         bacs_variable_assignment<FieldType> result;
+                        result.reserve(num_wires());
                         result.insert(result.end(), primary_input.begin(), primary_input.end());
                         result.insert(result.end(), auxiliary_input.begin(), auxiliary_input.end());
 
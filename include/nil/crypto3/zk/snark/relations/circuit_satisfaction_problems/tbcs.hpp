@@ -24,7 +24,8 @@
 //---------------------------------------------------------------------------//
 // @file Declaration of interfaces for:
 // - a TBCS gate,
-// - a TBCS variable assignment, and
+// - a TBCS variable assignment,
+// - a TBCS bit-sliced variable assignment, and
 // - a TBCS circuit.
 //
 // Above, TBCS stands for "Two-input Boolean Circuit Satisfiability".
@@ -33,6 +34,14 @@
 #ifndef CRYPTO3_ZK_TBCS_HPP
 #define CRYPTO3_ZK_TBCS_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 #include <nil/crypto3/zk/snark/relations/variable.hpp>
 
 namespace nil {
@@ -47,6 +56,49 @@ namespace nil {
                  */
                 typedef std::vector<bool> tbcs_variable_assignment;
 
+                /****************** TBCS bit-sliced variable assignment **********************/
+
+                /**
+                 * A TBCS bit-sliced variable assignment holds tbcs_slice_width independent assignments, one per
+                 * bit position: word i carries the value of variable i+1 in every one of them.
+                 */
+                typedef std::uint64_t tbcs_slice;
+                typedef std::vector<tbcs_slice> tbcs_sliced_variable_assignment;
+
+                static const std::size_t tbcs_slice_width = 64;
+
+                /**
+                 * Pack assignments[first, first + count), count <= tbcs_slice_width, into a bit-sliced
+                 * assignment; unused bit positions are zero.
+                 */
+                inline tbcs_sliced_variable_assignment
+                    tbcs_slice_assignments(const std::vector<tbcs_variable_assignment> &assignments,
+                                           std::size_t first, std::size_t count) {
+                    assert(count <= tbcs_slice_width);
+                    tbcs_sliced_variable_assignment result(count == 0 ? 0 : assignments[first].size(), 0);
+                    for (std::size_t k = 0; k < count; ++k) {
+                        const tbcs_variable_assignment &assignment = assignments[first + k];
+                        assert(assignment.size() == result.size());
+                        for (std::size_t i = 0; i < assignment.size(); ++i) {
+                            result[i] |= tbcs_slice(assignment[i]) << k;
+                        }
+                    }
+                    return result;
+                }
+
+                /**
+                 * The assignment in bit position k of a bit-sliced assignment.
+                 */
+                inline tbcs_variable_assignment tbcs_unslice_assignment(const tbcs_sliced_variable_assignment &sliced,
+                                                                        std::size_t k) {
+                    assert(k < tbcs_slice_width);
+                    tbcs_variable_assignment result(sliced.size());
+                    for (std::size_t i = 0; i < sliced.size(); ++i) {
+                        result[i] = (sliced[i] >> k) & 1;
+                    }
+                    return result;
+                }
+
                 /**************************** TBCS gate **************************************/
 
                 typedef std::size_t tbcs_wire_t;
@@ -125,6 +177,19 @@ namespace nil {
                         return (((int)type) & (1u << pos));
                     }
 
+                    /**
+                     * Bit-sliced evaluation: the gate is evaluated on every bit position of the input at once.
+                     * The opcode bits select which of the four minterms of X and Y are in the output.
+                     */
+                    tbcs_slice evaluate(const tbcs_sliced_variable_assignment &input) const {
+                        const tbcs_slice X = (left_wire == 0 ? ~tbcs_slice(0) : input[left_wire - 1]);
+                        const tbcs_slice Y = (right_wire == 0 ? ~tbcs_slice(0) : input[right_wire - 1]);
+
+                        const tbcs_slice t = tbcs_slice(type);
+                        return (-((t >> 3) & 1) & ~X & ~Y) | (-((t >> 2) & 1) & ~X & Y) |
+                               (-((t >> 1) & 1) & X & ~Y) | (-(t & 1) & X & Y);
+                    }
+
                     bool operator==(const tbcs_gate &other) const {
                         return (this->left_wire == other.left_wire && this->right_wire == other.right_wire &&
                                 this->type == other.type && this->output == other.output &&
@@ -258,6 +323,101 @@ namespace nil {
                         return all_outputs;
                     }
 
+                    /**
+                     * Bit-sliced counterpart of get_all_wires(): evaluates the circuit on up to
+                     * tbcs_slice_width assignments at once.
+                     */
+                    tbcs_sliced_variable_assignment
+                        get_all_wires(const tbcs_sliced_variable_assignment &primary_input,
+                                      const tbcs_sliced_variable_assignment &auxiliary_input) const {
+                        assert(primary_input.size() == primary_input_size);
+                        assert(auxiliary_input.size() == auxiliary_input_size);
+
+                        tbcs_sliced_variable_assignment result;
+                        result.reserve(num_wires());
+                        result.insert(result.end(), primary_input.begin(), primary_input.end());
+                        result.insert(result.end(), auxiliary_input.begin(), auxiliary_input.end());
+
+                        for (auto &g : gates) {
+                            const tbcs_slice gate_output = g.evaluate(result);
+                            result.push_back(gate_output);
+                        }
+
+                        return result;
+                    }
+
+                    /**
+                     * Bit-sliced counterpart of is_satisfied(): bit k of the result is set iff the assignment in
+                     * bit position k satisfies the circuit.
+                     */
+                    tbcs_slice is_satisfied(const tbcs_sliced_variable_assignment &primary_input,
+                                            const tbcs_sliced_variable_assignment &auxiliary_input) const {
+                        const tbcs_sliced_variable_assignment all_wires = get_all_wires(primary_input, auxiliary_input);
+
+                        tbcs_slice any_output = 0;
+                        for (auto &g : gates) {
+                            if (g.is_circuit_output) {
+                                any_output |= all_wires[g.output - 1];
+                            }
+                        }
+
+                        return ~any_output;
+                    }
+
+                    /**
+                     * Check many pairs of inputs, tbcs_slice_width at a time.
+                     */
+                    std::vector<bool> is_satisfied(const std::vector<tbcs_primary_input> &primary_inputs,
+                                                   const std::vector<tbcs_auxiliary_input> &auxiliary_inputs) const {
+                        assert(primary_inputs.size() == auxiliary_inputs.size());
+                        const std::size_t batches = (primary_inputs.size() + tbcs_slice_width - 1) / tbcs_slice_width;
+
+                        std::vector<bool> result(primary_inputs.size());
+                        std::vector<tbcs_slice> satisfied(batches);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t b = 0; b < batches; ++b) {
+                            const std::size_t first = b * tbcs_slice_width,
+                                              count = std::min(tbcs_slice_width, primary_inputs.size() - first);
+                            satisfied[b] = is_satisfied(tbcs_slice_assignments(primary_inputs, first, count),
+                                                        tbcs_slice_assignments(auxiliary_inputs, first, count));
+                        }
+
+                        for (std::size_t i = 0; i < result.size(); ++i) {
+                            result[i] = (satisfied[i / tbcs_slice_width] >> (i % tbcs_slice_width)) & 1;
+                        }
+
+                        return result;
+                    }
+
+                    /**
+                     * Evaluate the circuit on many pairs of inputs, tbcs_slice_width at a time.
+                     */
+                    std::vector<tbcs_variable_assignment>
+                        get_all_wires(const std::vector<tbcs_primary_input> &primary_inputs,
+                                      const std::vector<tbcs_auxiliary_input> &auxiliary_inputs) const {
+                        assert(primary_inputs.size() == auxiliary_inputs.size());
+                        const std::size_t batches = (primary_inputs.size() + tbcs_slice_width - 1) / tbcs_slice_width;
+
+                        std::vector<tbcs_variable_assignment> result(primary_inputs.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t b = 0; b < batches; ++b) {
+                            const std::size_t first = b * tbcs_slice_width,
+                                              count = std::min(tbcs_slice_width, primary_inputs.size() - first);
+                            const tbcs_sliced_variable_assignment all_wires =
+                                get_all_wires(tbcs_slice_assignments(primary_inputs, first, count),
+                                              tbcs_slice_assignments(auxiliary_inputs, first, count));
+                            for (std::size_t k = 0; k < count; ++k) {
+                                result[first + k] = tbcs_unslice_assignment(all_wires, k);
+                            }
+                        }
+
+                        return result;
+                    }
+
                     void add_gate(const tbcs_gate &g) {
                         assert(g.output == num_wires() + 1);
                         gates.emplace_back(g);
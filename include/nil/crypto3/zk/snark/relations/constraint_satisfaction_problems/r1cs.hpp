@@ -188,7 +188,7 @@ namespace nil {
                         constraints.emplace_back(c);
                     }
 
-                    void swap_AB_if_beneficial() {
+                    bool is_swap_AB_beneficial() const {
                         std::vector<bool> touched_by_A(this->num_variables() + 1, false),
                             touched_by_B(this->num_variables() + 1, false);
 
@@ -208,7 +208,11 @@ namespace nil {
                             non_zero_B_count += touched_by_B[i] ? 1 : 0;
                         }
 
-                        if (non_zero_B_count > non_zero_A_count) {
+                        return non_zero_B_count > non_zero_A_count;
+                    }
+
+                    void swap_AB_if_beneficial() {
+                        if (is_swap_AB_beneficial()) {
                             for (std::size_t i = 0; i < this->constraints.size(); ++i) {
                                 std::swap(this->constraints[i].a, this->constraints[i].b);
                             }
@@ -0,0 +1,290 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Declaration of interfaces for an optimization pass over a R1CS constraint system:
+// - duplicate terms of every linear combination are merged and zero terms dropped,
+// - linear constraints are used to substitute away an auxiliary variable,
+// - auxiliary variables no longer referenced are removed.
+//
+// The optimized system has the same primary input; its auxiliary input is a
+// subset of the original one, selected by auxiliary_input_map().
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_R1CS_OPTIMIZER_HPP
+#define CRYPTO3_ZK_R1CS_OPTIMIZER_HPP
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs.hpp>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * A R1CS constraint system produced by r1cs_optimizer, together with the map from witnesses of
+                 * the original system to witnesses of this one.
+                 */
+                template<typename FieldType>
+                struct r1cs_optimized_constraint_system {
+                    typedef FieldType field_type;
+
+                    r1cs_constraint_system<FieldType> constraint_system;
+
+                    /* index in the original auxiliary input of every auxiliary variable of constraint_system */
+                    std::vector<std::size_t> auxiliary_variables;
+
+                    r1cs_auxiliary_input<FieldType>
+                        auxiliary_input_map(const r1cs_auxiliary_input<FieldType> &auxiliary_input) const {
+                        r1cs_auxiliary_input<FieldType> result;
+                        result.reserve(auxiliary_variables.size());
+                        for (std::size_t i : auxiliary_variables) {
+                            result.emplace_back(auxiliary_input[i]);
+                        }
+                        return result;
+                    }
+                };
+
+                /**
+                 * Optimization pass shrinking the number of constraints and variables of a R1CS constraint
+                 * system before the generator runs on it.
+                 *
+                 * A constraint is linear when A or B is a constant: it then reads L = 0 for a linear combination
+                 * L. If L involves an auxiliary variable, that variable is expressed from L and substituted in
+                 * every other constraint, and the constraint is dropped. The auxiliary variable occurring in the
+                 * fewest constraints is chosen, to keep the fill-in low; linear constraints with more than
+                 * max_substitution_terms terms are kept as they are.
+                 *
+                 * Every witness of the original system maps to a witness of the optimized one by dropping the
+                 * eliminated variables, and every witness of the optimized system extends to one of the original
+                 * system, so both prove the same statements about the primary input.
+                 */
+                template<typename FieldType>
+                struct r1cs_optimizer {
+                    typedef FieldType field_type;
+                    typedef typename FieldType::value_type field_value_type;
+
+                    static r1cs_optimized_constraint_system<FieldType>
+                        process(const r1cs_constraint_system<FieldType> &cs,
+                                std::size_t max_substitution_terms = std::numeric_limits<std::size_t>::max()) {
+                        std::vector<r1cs_constraint<FieldType>> constraints = cs.constraints;
+                        std::vector<bool> removed(constraints.size(), false);
+
+                        /* constraints every variable occurs in; may hold duplicates and stale entries */
+                        std::vector<std::vector<std::size_t>> occurrences(cs.num_variables() + 1);
+                        for (std::size_t i = 0; i < constraints.size(); ++i) {
+                            normalize(constraints[i].a);
+                            normalize(constraints[i].b);
+                            normalize(constraints[i].c);
+                            for (const linear_combination<FieldType> *lc :
+                                 {&constraints[i].a, &constraints[i].b, &constraints[i].c}) {
+                                for (const linear_term<FieldType> &lt : lc->terms) {
+                                    occurrences[lt.index].push_back(i);
+                                }
+                            }
+                        }
+
+                        std::deque<std::size_t> worklist;
+                        std::vector<bool> queued(constraints.size(), true);
+                        for (std::size_t i = 0; i < constraints.size(); ++i) {
+                            worklist.push_back(i);
+                        }
+
+                        while (!worklist.empty()) {
+                            const std::size_t i = worklist.front();
+                            worklist.pop_front();
+                            queued[i] = false;
+
+                            linear_combination<FieldType> L;
+                            if (removed[i] || !linear_form(constraints[i], L)) {
+                                continue;
+                            }
+                            if (L.terms.empty()) {
+                                /* 0 = 0 */
+                                removed[i] = true;
+                                continue;
+                            }
+                            if (L.terms.size() > max_substitution_terms) {
+                                continue;
+                            }
+
+                            /* pick the auxiliary variable of L occurring in the fewest constraints */
+                            std::size_t pivot = 0;
+                            for (const linear_term<FieldType> &lt : L.terms) {
+                                if (lt.index > cs.num_inputs() &&
+                                    (pivot == 0 || occurrences[lt.index].size() < occurrences[pivot].size())) {
+                                    pivot = lt.index;
+                                }
+                            }
+                            if (pivot == 0) {
+                                continue;
+                            }
+
+                            /* x_pivot = -(L - c * x_pivot) / c */
+                            auto pivot_it = find_term(L, pivot);
+                            const field_value_type scale = -pivot_it->coeff.inversed();
+                            L.terms.erase(pivot_it);
+                            const linear_combination<FieldType> expression = L * scale;
+
+                            removed[i] = true;
+                            for (std::size_t j : occurrences[pivot]) {
+                                if (removed[j]) {
+                                    continue;
+                                }
+                                bool changed = substitute(constraints[j].a, pivot, expression);
+                                changed = substitute(constraints[j].b, pivot, expression) || changed;
+                                changed = substitute(constraints[j].c, pivot, expression) || changed;
+                                if (!changed) {
+                                    continue;
+                                }
+                                for (const linear_term<FieldType> &lt : expression.terms) {
+                                    occurrences[lt.index].push_back(j);
+                                }
+                                if (!queued[j]) {
+                                    queued[j] = true;
+                                    worklist.push_back(j);
+                                }
+                            }
+                            std::vector<std::size_t>().swap(occurrences[pivot]);
+                        }
+
+                        return compact(cs, constraints, removed);
+                    }
+
+                private:
+                    /* sort, merge duplicate terms and drop zero terms */
+                    static void normalize(linear_combination<FieldType> &lc) {
+                        lc = linear_combination<FieldType>(lc.terms);
+                        drop_zero_terms(lc);
+                    }
+
+                    static void drop_zero_terms(linear_combination<FieldType> &lc) {
+                        lc.terms.erase(
+                            std::remove_if(lc.terms.begin(), lc.terms.end(),
+                                           [](const linear_term<FieldType> &lt) { return lt.coeff.is_zero(); }),
+                            lc.terms.end());
+                    }
+
+                    static bool is_constant(const linear_combination<FieldType> &lc) {
+                        return lc.terms.empty() || (lc.terms.size() == 1 && lc.terms[0].index == 0);
+                    }
+
+                    static field_value_type constant_value(const linear_combination<FieldType> &lc) {
+                        return lc.terms.empty() ? field_value_type::zero() : lc.terms[0].coeff;
+                    }
+
+                    static typename std::vector<linear_term<FieldType>>::iterator
+                        find_term(linear_combination<FieldType> &lc, std::size_t index) {
+                        auto it = std::lower_bound(
+                            lc.terms.begin(), lc.terms.end(), index,
+                            [](const linear_term<FieldType> &lt, std::size_t index) { return lt.index < index; });
+                        return (it != lc.terms.end() && it->index == index) ? it : lc.terms.end();
+                    }
+
+                    /* if A or B is constant, write the constraint as L = 0 */
+                    static bool linear_form(const r1cs_constraint<FieldType> &constraint,
+                                            linear_combination<FieldType> &L) {
+                        if (is_constant(constraint.a)) {
+                            L = constraint.b * constant_value(constraint.a) - constraint.c;
+                        } else if (is_constant(constraint.b)) {
+                            L = constraint.a * constant_value(constraint.b) - constraint.c;
+                        } else {
+                            return false;
+                        }
+                        drop_zero_terms(L);
+                        return true;
+                    }
+
+                    /* replace x_index by expression in lc; returns whether lc contained x_index */
+                    static bool substitute(linear_combination<FieldType> &lc, std::size_t index,
+                                           const linear_combination<FieldType> &expression) {
+                        auto it = find_term(lc, index);
+                        if (it == lc.terms.end()) {
+                            return false;
+                        }
+                        const field_value_type coeff = it->coeff;
+                        lc.terms.erase(it);
+                        lc = lc + expression * coeff;
+                        drop_zero_terms(lc);
+                        return true;
+                    }
+
+                    /* drop the removed constraints and renumber the auxiliary variables still referenced */
+                    static r1cs_optimized_constraint_system<FieldType>
+                        compact(const r1cs_constraint_system<FieldType> &cs,
+                                std::vector<r1cs_constraint<FieldType>> &constraints,
+                                const std::vector<bool> &removed) {
+                        std::vector<bool> used(cs.num_variables() + 1, false);
+                        for (std::size_t i = 0; i < constraints.size(); ++i) {
+                            if (removed[i]) {
+                                continue;
+                            }
+                            for (const linear_combination<FieldType> *lc :
+                                 {&constraints[i].a, &constraints[i].b, &constraints[i].c}) {
+                                for (const linear_term<FieldType> &lt : lc->terms) {
+                                    used[lt.index] = true;
+                                }
+                            }
+                        }
+
+                        r1cs_optimized_constraint_system<FieldType> result;
+                        std::vector<std::size_t> new_index(cs.num_variables() + 1);
+                        for (std::size_t i = 0; i <= cs.num_inputs(); ++i) {
+                            new_index[i] = i;
+                        }
+                        for (std::size_t i = cs.num_inputs() + 1; i <= cs.num_variables(); ++i) {
+                            if (used[i]) {
+                                result.auxiliary_variables.push_back(i - cs.num_inputs() - 1);
+                                new_index[i] = cs.num_inputs() + result.auxiliary_variables.size();
+                            }
+                        }
+
+                        result.constraint_system.primary_input_size = cs.num_inputs();
+                        result.constraint_system.auxiliary_input_size = result.auxiliary_variables.size();
+                        for (std::size_t i = 0; i < constraints.size(); ++i) {
+                            if (removed[i]) {
+                                continue;
+                            }
+                            for (linear_combination<FieldType> *lc :
+                                 {&constraints[i].a, &constraints[i].b, &constraints[i].c}) {
+                                for (linear_term<FieldType> &lt : lc->terms) {
+                                    lt.index = new_index[lt.index];
+                                }
+                            }
+                            result.constraint_system.constraints.emplace_back(std::move(constraints[i]));
+                        }
+
+                        return result;
+                    }
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_R1CS_OPTIMIZER_HPP
@@ -0,0 +1,208 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Declaration of interfaces for a column-major sparse matrix.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_SPARSE_MATRIX_HPP
+#define CRYPTO3_ZK_SPARSE_MATRIX_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * A sparse matrix over <FieldType> stored column by column (CSC): the nonzero entries of
+                 * column i are rows[offsets[i] .. offsets[i + 1]) with the corresponding values, sorted by row.
+                 *
+                 * Arithmetic programs use it for the Lagrange basis coefficients of their polynomials: column i
+                 * holds the coefficients of the i-th polynomial, row j is the j-th point of the domain.
+                 */
+                template<typename FieldType>
+                struct sparse_matrix {
+                    typedef FieldType field_type;
+                    typedef typename FieldType::value_type value_type;
+
+                    /**
+                     * An (unordered) entry used to build the matrix. Entries at the same position are summed.
+                     */
+                    struct entry_type {
+                        std::size_t column;
+                        std::size_t row;
+                        value_type value;
+                    };
+
+                    std::vector<std::size_t> offsets;
+                    std::vector<std::size_t> rows;
+                    std::vector<value_type> values;
+
+                    sparse_matrix() : offsets(1, 0) {
+                    }
+
+                    /**
+                     * Bucket the entries by column, then sort and merge each column independently. Counting and
+                     * scattering run in parallel over the entries (threads claim slots of a column with atomic
+                     * increments, so the order inside a bucket is arbitrary until it is sorted); only the prefix
+                     * sum over the column sizes is serial. The entries are released as soon as they are bucketed.
+                     */
+                    sparse_matrix(std::size_t num_columns, std::vector<entry_type> &&entries) :
+                        offsets(num_columns + 1, 0) {
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t k = 0; k < entries.size(); ++k) {
+#ifdef MULTICORE
+#pragma omp atomic
+#endif
+                            ++offsets[entries[k].column + 1];
+                        }
+                        for (std::size_t i = 0; i < num_columns; ++i) {
+                            offsets[i + 1] += offsets[i];
+                        }
+
+                        std::vector<std::pair<std::size_t, value_type>> cells(entries.size());
+                        std::vector<std::size_t> position(offsets.begin(), offsets.end() - 1);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t k = 0; k < entries.size(); ++k) {
+                            std::size_t slot;
+#ifdef MULTICORE
+#pragma omp atomic capture
+#endif
+                            slot = position[entries[k].column]++;
+                            cells[slot] = std::make_pair(entries[k].row, std::move(entries[k].value));
+                        }
+                        std::vector<entry_type>().swap(entries);
+
+                        /* number of distinct nonzero rows left at the beginning of every column */
+                        std::vector<std::size_t> merged_sizes(num_columns, 0);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < num_columns; ++i) {
+                            auto first = cells.begin() + offsets[i], last = cells.begin() + offsets[i + 1];
+                            std::sort(first, last, [](const std::pair<std::size_t, value_type> &a,
+                                                      const std::pair<std::size_t, value_type> &b) {
+                                return a.first < b.first;
+                            });
+
+                            auto out = first;
+                            for (auto it = first; it != last;) {
+                                std::pair<std::size_t, value_type> merged = *it;
+                                for (++it; it != last && it->first == merged.first; ++it) {
+                                    merged.second += it->second;
+                                }
+                                if (!merged.second.is_zero()) {
+                                    *out++ = merged;
+                                }
+                            }
+                            merged_sizes[i] = out - first;
+                        }
+
+                        std::vector<std::size_t> bucket_offsets;
+                        bucket_offsets.swap(offsets);
+                        offsets.resize(num_columns + 1, 0);
+                        for (std::size_t i = 0; i < num_columns; ++i) {
+                            offsets[i + 1] = offsets[i] + merged_sizes[i];
+                        }
+
+                        rows.resize(offsets[num_columns]);
+                        values.resize(offsets[num_columns]);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < num_columns; ++i) {
+                            for (std::size_t j = 0; j < merged_sizes[i]; ++j) {
+                                rows[offsets[i] + j] = cells[bucket_offsets[i] + j].first;
+                                values[offsets[i] + j] = std::move(cells[bucket_offsets[i] + j].second);
+                            }
+                        }
+                    }
+
+                    sparse_matrix(const sparse_matrix<FieldType> &other) = default;
+                    sparse_matrix(sparse_matrix<FieldType> &&other) = default;
+                    sparse_matrix<FieldType> &operator=(const sparse_matrix<FieldType> &other) = default;
+                    sparse_matrix<FieldType> &operator=(sparse_matrix<FieldType> &&other) = default;
+
+                    std::size_t num_columns() const {
+                        return offsets.size() - 1;
+                    }
+
+                    /* number of stored entries */
+                    std::size_t size() const {
+                        return rows.size();
+                    }
+
+                    std::size_t column_size(std::size_t column) const {
+                        return offsets[column + 1] - offsets[column];
+                    }
+
+                    value_type operator()(std::size_t column, std::size_t row) const {
+                        auto first = rows.begin() + offsets[column], last = rows.begin() + offsets[column + 1];
+                        auto it = std::lower_bound(first, last, row);
+                        return (it != last && *it == row) ? values[it - rows.begin()] : value_type::zero();
+                    }
+
+                    /* \sum_j point[j] * M[j][column] */
+                    value_type evaluate_column(std::size_t column, const std::vector<value_type> &point) const {
+                        value_type result = value_type::zero();
+                        for (std::size_t k = offsets[column]; k < offsets[column + 1]; ++k) {
+                            result += point[rows[k]] * values[k];
+                        }
+                        return result;
+                    }
+
+                    /* (evaluate_column(0, point), ..., evaluate_column(num_columns() - 1, point)) */
+                    std::vector<value_type> evaluate(const std::vector<value_type> &point) const {
+                        std::vector<value_type> result(num_columns());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < num_columns(); ++i) {
+                            result[i] = evaluate_column(i, point);
+                        }
+                        return result;
+                    }
+
+                    bool operator==(const sparse_matrix<FieldType> &other) const {
+                        return (this->offsets == other.offsets && this->rows == other.rows &&
+                                this->values == other.values);
+                    }
+                };
+            }    // namespace snark
+        }        // namespace zk
+    }            // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_SPARSE_MATRIX_HPP
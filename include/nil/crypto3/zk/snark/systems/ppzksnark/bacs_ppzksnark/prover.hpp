@@ -26,8 +26,12 @@
 #ifndef CRYPTO3_ZK_BACS_PPZKSNARK_BASIC_PROVER_HPP
 #define CRYPTO3_ZK_BACS_PPZKSNARK_BASIC_PROVER_HPP
 
+#include <nil/crypto3/algebra/random_element.hpp>
+
 #include <nil/crypto3/zk/snark/relations/circuit_satisfaction_problems/bacs.hpp>
 #include <nil/crypto3/zk/snark/reductions/bacs_to_r1cs.hpp>
+#include <nil/crypto3/zk/snark/reductions/r1cs_to_qap.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_ppzksnark/prover.hpp>
 
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/r1cs_ppzksnark.hpp>
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/bacs_ppzksnark/detail/basic_policy.hpp>
@@ -63,20 +67,56 @@ namespace nil {
                     typedef typename policy_type::keypair_type keypair_type;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * Buffers reused across proofs for one proving key, see r1cs_to_qap::workspace_type, the
+                     * levelized form of its circuit and whether the generator swapped the A and B sides of its
+                     * constraint system.
+                     */
+                    struct workspace_type {
+                        explicit workspace_type(const proving_key_type &proving_key) :
+                            qap(proving_key.r1cs_pk.constraint_system), circuit(proving_key.circuit.levelized()),
+                            swap_AB(reductions::bacs_to_r1cs<typename CurveType::scalar_field_type>::is_swapped_AB(
+                                proving_key.circuit, proving_key.r1cs_pk.constraint_system)) {
+                        }
+
+                        typename r1cs_ppzksnark_prover<CurveType>::workspace_type qap;
+                        bacs_levelized_circuit<typename CurveType::scalar_field_type> circuit;
+                        bool swap_AB;
+                    };
+
                     static inline proof_type process(const proving_key_type &proving_key,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        workspace_type workspace(proving_key);
+
+                        return process(proving_key, primary_input, auxiliary_input, workspace);
+                    }
 
+                    /**
+                     * The circuit is evaluated straight into the QAP witness, together with the values of the
+                     * R1CS constraints, so the wires are neither copied into a separate R1CS assignment nor
+                     * re-evaluated through the constraints.
+                     */
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     workspace_type &workspace) {
                         typedef typename CurveType::scalar_field_type field_type;
 
-                        const r1cs_variable_assignment<field_type> r1cs_va =
-                            reductions::bacs_to_r1cs<field_type>::witness_map(proving_key.circuit, primary_input, auxiliary_input);
-                        const r1cs_auxiliary_input<field_type> r1cs_ai(
-                            r1cs_va.begin() + primary_input.size(),
-                            r1cs_va.end());    // TODO: faster to just change bacs_to_r1cs<field_type>::witness_map into two :(
+                        assert(workspace.circuit.is_satisfied(primary_input, auxiliary_input));
+
+                        const typename field_type::value_type d1 = algebra::random_element<field_type>(),
+                                                              d2 = algebra::random_element<field_type>(),
+                                                              d3 = algebra::random_element<field_type>();
+
+                        reductions::bacs_to_r1cs<field_type>::witness_map(workspace.circuit, primary_input,
+                                                                          auxiliary_input, workspace.swap_AB,
+                                                                          workspace.qap);
+                        const qap_witness<field_type> &qap_wit =
+                            reductions::r1cs_to_qap<field_type>::witness_map_from_evaluations(
+                                proving_key.r1cs_pk.constraint_system, d1, d2, d3, workspace.qap);
 
-                        return prove<r1cs_ppzksnark<CurveType>>(
-                            proving_key.r1cs_pk, primary_input, r1cs_ai);
+                        return r1cs_ppzksnark_prover<CurveType>::process(proving_key.r1cs_pk, qap_wit);
                     }
                 };
             }    // namespace snark
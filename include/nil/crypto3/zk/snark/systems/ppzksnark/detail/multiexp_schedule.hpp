@@ -0,0 +1,118 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2018-2021 Mikhail Komarov <nemo@nil.foundation>
+// Copyright (c) 2020-2021 Nikita Kaskov <nbering@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Scheduling of the multi-exponentiations of a prover.
+//
+// A prover computes a handful of independent multi-exponentiations. Run one
+// after another, each is chunked over the threads, but the threads idle at the
+// end of every chunk loop while the slowest chunk finishes. The concurrent
+// schedule splits every multi-exponentiation into pieces and runs the pieces of
+// all of them in a single dynamically scheduled loop, then adds up the partial
+// results.
+//---------------------------------------------------------------------------//
+
+#ifndef CRYPTO3_ZK_PPZKSNARK_MULTIEXP_SCHEDULE_HPP
+#define CRYPTO3_ZK_PPZKSNARK_MULTIEXP_SCHEDULE_HPP
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nil {
+    namespace crypto3 {
+        namespace zk {
+            namespace snark {
+
+                /**
+                 * How a prover runs its multi-exponentiations, see concurrent_multiexps.
+                 */
+                enum class multiexp_schedule { sequential, concurrent };
+
+                namespace detail {
+
+                    /**
+                     * A batch of independent multi-exponentiations run on a shared pool of threads.
+                     *
+                     * Every multi-exponentiation is given as the length of its input and a function computing
+                     * the partial result over a subrange [first, last) of it, single-threaded. run() computes all
+                     * the pieces in one parallel loop and adds the partial results to the given accumulators.
+                     */
+                    class concurrent_multiexps {
+                    public:
+                        explicit concurrent_multiexps(std::size_t pieces_per_multiexp) :
+                            pieces_per_multiexp(std::max<std::size_t>(1, pieces_per_multiexp)) {
+                        }
+
+                        template<typename ResultType, typename PartialFunction>
+                        void add(ResultType &result, std::size_t length, PartialFunction partial) {
+                            const std::size_t pieces = std::max<std::size_t>(1, std::min(pieces_per_multiexp, length));
+                            std::shared_ptr<std::vector<ResultType>> partials =
+                                std::make_shared<std::vector<ResultType>>(pieces, ResultType::zero());
+
+                            for (std::size_t i = 0; i < pieces; ++i) {
+                                const std::size_t first = length * i / pieces, last = length * (i + 1) / pieces;
+                                tasks.emplace_back([partials, partial, i, first, last]() {
+                                    (*partials)[i] = partial(first, last);
+                                });
+                            }
+                            reductions.emplace_back([partials, &result]() {
+                                for (const ResultType &p : *partials) {
+                                    result = result + p;
+                                }
+                            });
+                        }
+
+                        void run() {
+#ifdef MULTICORE
+#pragma omp parallel for schedule(dynamic)
+#endif
+                            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                                tasks[i]();
+                            }
+
+                            for (const std::function<void()> &reduction : reductions) {
+                                reduction();
+                            }
+
+                            tasks.clear();
+                            reductions.clear();
+                        }
+
+                    private:
+                        std::size_t pieces_per_multiexp;
+                        std::vector<std::function<void()>> tasks;
+                        std::vector<std::function<void()>> reductions;
+                    };
+                }    // namespace detail
+            }        // namespace snark
+        }            // namespace zk
+    }                // namespace crypto3
+}    // namespace nil
+
+#endif    // CRYPTO3_ZK_PPZKSNARK_MULTIEXP_SCHEDULE_HPP
@@ -27,6 +27,7 @@
 #ifndef CRYPTO3_R1CS_GG_PPZKSNARK_HPP
 #define CRYPTO3_R1CS_GG_PPZKSNARK_HPP
 
+#include <memory>
 #include <type_traits>
 
 #include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/detail/basic_policy.hpp>
@@ -53,10 +54,9 @@ namespace nil {
                     (std::is_same<r1cs_gg_ppzksnark_verifier_weak_input_consistency<CurveType, ProvingMode::Basic>,
                                   Verifier>::value ||
                      std::is_same<r1cs_gg_ppzksnark_verifier_strong_input_consistency<CurveType, ProvingMode::Basic>,
-                                  Verifier>::value
-                     // || std::is_same<r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency<CurveType>,
-                     //               Verifier>::value
-                     )>;
+                                  Verifier>::value ||
+                     std::is_same<r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency<CurveType>,
+                                  Verifier>::value)>;
 
                 template<typename CurveType, typename Generator, typename Prover, typename Verifier>
                 using is_aggregate_mode = typename std::bool_constant<
@@ -131,6 +131,13 @@ namespace nil {
                         return Generator::template process<KeyPairType>(constraint_system);
                     }
 
+                    // Keys generated from the same shared constraint system reference it instead of copying it
+                    template<typename KeyPairType>
+                    static inline KeyPairType
+                        generate(const std::shared_ptr<const constraint_system_type> &constraint_system) {
+                        return Generator::template process<KeyPairType>(constraint_system);
+                    }
+
                     static inline proof_type prove(const proving_key_type &pk,
                                                    const primary_input_type &primary_input,
                                                    const auxiliary_input_type &auxiliary_input) {
@@ -138,6 +145,16 @@ namespace nil {
                         return Prover::process(pk, primary_input, auxiliary_input);
                     }
 
+                    // Prove reusing the buffers of a Prover::workspace_type created once for pk
+                    template<typename WorkspaceType>
+                    static inline proof_type prove(const proving_key_type &pk,
+                                                   const primary_input_type &primary_input,
+                                                   const auxiliary_input_type &auxiliary_input,
+                                                   WorkspaceType &workspace) {
+
+                        return Prover::process(pk, primary_input, auxiliary_input, workspace);
+                    }
+
                     template<typename VerificationKey>
                     static inline bool verify(const VerificationKey &vk,
                                               const primary_input_type &primary_input,
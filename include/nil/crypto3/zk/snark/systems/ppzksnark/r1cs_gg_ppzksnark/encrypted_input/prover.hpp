@@ -26,6 +26,15 @@
 #ifndef CRYPTO3_ZK_R1CS_GG_PPZKSNARK_ENCRYPTED_INPUT_PROVER_HPP
 #define CRYPTO3_ZK_R1CS_GG_PPZKSNARK_ENCRYPTED_INPUT_PROVER_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <nil/crypto3/algebra/multiexp/multiexp.hpp>
+
 #include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/prover.hpp>
 
 namespace nil {
@@ -71,6 +80,68 @@ namespace nil {
                                           std::move(proof.g_B),
                                           std::move(r * pubkey.gamma_inverse_sum_s_g1 + proof.g_C));
                     }
+
+                    /**
+                     * Prove many statements under one proving key and one public key; rs[i] is the randomness
+                     * the primary input i was encrypted with.
+                     *
+                     * The proofs are generated in parallel, every thread reusing one basic prover workspace for
+                     * its share of the statements, and the r * gamma_inverse_sum_s_g1 terms are computed from a
+                     * fixed-base window table. The zero-knowledge randomness of every proof is drawn beforehand,
+                     * so the random generator is not shared between threads.
+                     */
+                    template<typename PublicKey>
+                    static inline std::vector<proof_type>
+                        process(const proving_key_type &gg_proving_key,
+                                const PublicKey &pubkey,
+                                const std::vector<primary_input_type> &primary_inputs,
+                                const std::vector<auxiliary_input_type> &auxiliary_inputs,
+                                const std::vector<typename scalar_field_type::value_type> &rs) {
+                        BOOST_ASSERT(primary_inputs.size() == auxiliary_inputs.size());
+                        BOOST_ASSERT(primary_inputs.size() == rs.size());
+
+                        const std::size_t num_proofs = primary_inputs.size();
+                        const std::size_t scalar_size = scalar_field_type::value_bits;
+                        const std::size_t window = algebra::get_exp_window_size<g1_type>(num_proofs);
+                        const algebra::window_table<g1_type> table =
+                            algebra::get_window_table<g1_type>(scalar_size, window, pubkey.gamma_inverse_sum_s_g1);
+
+                        std::vector<typename scalar_field_type::value_type> zk_randomness;
+                        zk_randomness.reserve(2 * num_proofs);
+                        for (std::size_t i = 0; i < 2 * num_proofs; ++i) {
+                            zk_randomness.emplace_back(algebra::random_element<scalar_field_type>());
+                        }
+
+#ifdef MULTICORE
+                        const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                             // var or call omp_set_num_threads()
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t num_workspaces = std::min(chunks, num_proofs);
+                        std::vector<typename basic_prover_type::workspace_type> workspaces;
+                        workspaces.reserve(num_workspaces);
+                        for (std::size_t c = 0; c < num_workspaces; ++c) {
+                            workspaces.emplace_back(gg_proving_key);
+                        }
+
+                        std::vector<proof_type> proofs(num_proofs);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < num_workspaces; ++c) {
+                            for (std::size_t i = c; i < num_proofs; i += num_workspaces) {
+                                proofs[i] = basic_prover_type::process(gg_proving_key, primary_inputs[i],
+                                                                       auxiliary_inputs[i], zk_randomness[2 * i],
+                                                                       zk_randomness[2 * i + 1], workspaces[c]);
+                                proofs[i].g_C = algebra::windowed_exp<g1_type, scalar_field_type>(scalar_size, window,
+                                                                                                   table, rs[i]) +
+                                                proofs[i].g_C;
+                            }
+                        }
+
+                        return proofs;
+                    }
                 };
             }    // namespace snark
         }        // namespace zk
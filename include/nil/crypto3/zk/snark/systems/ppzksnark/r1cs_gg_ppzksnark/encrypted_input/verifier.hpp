@@ -50,6 +50,13 @@
 #ifndef CRYPTO3_ZK_R1CS_GG_PPZKSNARK_ENCRYPTED_INPUT_VERIFIER_HPP
 #define CRYPTO3_ZK_R1CS_GG_PPZKSNARK_ENCRYPTED_INPUT_VERIFIER_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
 #include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/verifier.hpp>
 
 namespace nil {
@@ -74,6 +81,41 @@ namespace nil {
                     typedef typename policy_type::verification_key_type verification_key_type;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * The verification key and the public key of the encryption with the Miller loop lines of
+                     * their G2 elements precomputed, for verifying many proofs with the same keys.
+                     */
+                    struct processed_key_type {
+                        typename gt_type::value_type alpha_g1_beta_g2;
+                        accumulation_vector<g1_type> gamma_ABC_g1;
+                        g2_precomputed_type gamma_g2_precomp;
+                        g2_precomputed_type delta_g2_precomp;
+                        g2_precomputed_type g2_one_precomp;
+                        std::vector<g2_precomputed_type> t_g2_precomp;
+                    };
+
+                    // TODO: add type constraints on PublicKey
+                    template<typename PublicKey>
+                    static inline processed_key_type process_key(const verification_key_type &gg_vk,
+                                                                 const PublicKey &pubkey) {
+                        processed_key_type processed_key;
+                        processed_key.alpha_g1_beta_g2 = gg_vk.alpha_g1_beta_g2;
+                        processed_key.gamma_ABC_g1 = gg_vk.gamma_ABC_g1;
+                        processed_key.gamma_g2_precomp = precompute_g2<CurveType>(gg_vk.gamma_g2);
+                        processed_key.delta_g2_precomp = precompute_g2<CurveType>(gg_vk.delta_g2);
+                        processed_key.g2_one_precomp = precompute_g2<CurveType>(g2_type::value_type::one());
+
+                        processed_key.t_g2_precomp.resize(pubkey.t_g2.size());
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t i = 0; i < pubkey.t_g2.size(); ++i) {
+                            processed_key.t_g2_precomp[i] = precompute_g2<CurveType>(pubkey.t_g2[i]);
+                        }
+
+                        return processed_key;
+                    }
+
                     // TODO: add type constraints on PublicKey
                     template<typename CipherTextIterator, typename PublicKey>
                     static inline typename std::enable_if<
@@ -83,66 +125,97 @@ namespace nil {
                         process(CipherTextIterator first, CipherTextIterator last, const verification_key_type &gg_vk,
                                 const PublicKey &pubkey, const primary_input_type &unencrypted_primary_input,
                                 const proof_type &proof) {
+                        assert(std::size_t(std::distance(first, last)) - 2 == pubkey.delta_s_g1.size());
+                        assert(std::size_t(std::distance(first, last)) - 2 == pubkey.t_g1.size());
+
+                        return process(first, last, process_key(gg_vk, pubkey), unencrypted_primary_input, proof);
+                    }
 
-                        const std::size_t input_size = gg_vk.gamma_ABC_g1.rest.size();
+                    /**
+                     * Both equations are checked with one final exponentiation each:
+                     *   prod_i e(ct_i, t_i) = e(ct_last, 1) as final_exp(prod_i ML(ct_i, t_i) / ML(ct_last, 1)) = 1,
+                     *   e(A, B) = alpha_beta * e(acc, gamma) * e(C, delta) as in the basic verifier.
+                     * The Miller loops of the first equation are paired up with double_miller_loop() and split
+                     * into chunks that run in parallel.
+                     */
+                    template<typename CipherTextIterator>
+                    static inline typename std::enable_if<
+                        std::is_same<typename g1_type::value_type,
+                                     typename std::iterator_traits<CipherTextIterator>::value_type>::value,
+                        bool>::type
+                        process(CipherTextIterator first, CipherTextIterator last,
+                                const processed_key_type &processed_key,
+                                const primary_input_type &unencrypted_primary_input, const proof_type &proof) {
+
+                        const std::size_t input_size = processed_key.gamma_ABC_g1.rest.size();
                         const std::size_t ct_size = std::distance(first, last);
+                        /* ciphertexts paired with t_g2, all but the last one */
+                        const std::size_t num_paired = ct_size - 1;
                         assert(input_size - 1 > ct_size - 2);
                         assert(unencrypted_primary_input.size() + (ct_size - 2) == input_size);
-                        assert(ct_size - 2 == pubkey.delta_s_g1.size());
-                        assert(ct_size - 2 == pubkey.t_g1.size());
-                        assert(ct_size - 2 == pubkey.t_g2.size() - 1);
-                        typename g1_type::value_type acc = gg_vk.gamma_ABC_g1.first;
-                        typename gt_type::value_type sum_cipher = gt_type::value_type::one();
-
-                        auto it1 = first;
-                        auto it2 = std::cbegin(pubkey.t_g2);
-                        while (it1 != last - 1 && it2 != std::cend(pubkey.t_g2)) {
-                            acc = acc + *it1;
-                            sum_cipher = sum_cipher * algebra::pair_reduced<CurveType>(*it1++, *it2++);
-                        }
-                        assert((it1 == last - 1) && (it2 == std::cend(pubkey.t_g2)));
+                        assert(num_paired == processed_key.t_g2_precomp.size());
 
+                        typename g1_type::value_type acc = processed_key.gamma_ABC_g1.first;
+                        for (auto it = first; it != last - 1; ++it) {
+                            acc = acc + *it;
+                        }
                         for (std::size_t i = ct_size - 2; i < input_size; ++i) {
-                            acc = acc + unencrypted_primary_input[i - ct_size + 2] * gg_vk.gamma_ABC_g1.rest[i];
+                            acc = acc + unencrypted_primary_input[i - ct_size + 2] * processed_key.gamma_ABC_g1.rest[i];
+                        }
+
+#ifdef MULTICORE
+                        const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                             // var or call omp_set_num_threads()
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        /* chunks hold an even number of pairs, so that they can go through double_miller_loop */
+                        const std::size_t chunk_size = 2 * ((num_paired + 2 * chunks - 1) / (2 * chunks));
+                        std::vector<typename gt_type::value_type> partial_miller(chunks, gt_type::value_type::one());
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < chunks; ++c) {
+                            const std::size_t begin = std::min(c * chunk_size, num_paired),
+                                              end = std::min(begin + chunk_size, num_paired);
+                            typename gt_type::value_type f = gt_type::value_type::one();
+                            std::size_t i = begin;
+                            for (; i + 1 < end; i += 2) {
+                                f = f * double_miller_loop<CurveType>(
+                                            precompute_g1<CurveType>(*(first + i)), processed_key.t_g2_precomp[i],
+                                            precompute_g1<CurveType>(*(first + i + 1)),
+                                            processed_key.t_g2_precomp[i + 1]);
+                            }
+                            if (i < end) {
+                                f = f * miller_loop<CurveType>(precompute_g1<CurveType>(*(first + i)),
+                                                               processed_key.t_g2_precomp[i]);
+                            }
+                            partial_miller[c] = f;
+                        }
+
+                        typename gt_type::value_type cipher_miller = gt_type::value_type::one();
+                        for (const typename gt_type::value_type &f : partial_miller) {
+                            cipher_miller = cipher_miller * f;
                         }
-                        typename gt_type::value_type presum_cipher =
-                            algebra::pair_reduced<CurveType>(*(last - 1), g2_type::value_type::one());
-                        bool ans1 = (sum_cipher == presum_cipher);
-
-                        // TODO: optimize
-                        typename gt_type::value_type QAPl = algebra::pair_reduced<CurveType>(proof.g_A, proof.g_B);
-                        typename gt_type::value_type QAPr = gg_vk.alpha_g1_beta_g2 *
-                                                            algebra::pair_reduced<CurveType>(acc, gg_vk.gamma_g2) *
-                                                            algebra::pair_reduced<CurveType>(proof.g_C, gg_vk.delta_g2);
-                        // const g1_precomputed_type proof_g1_A_precomp = precompute_g1<CurveType>(proof.g_A);
-                        // const g2_precomputed_type proof_g2_B_precomp = precompute_g2<CurveType>(proof.g_B);
-                        //
-                        // const g1_precomputed_type pk_g1_alpha_precomp =
-                        //     precompute_g1<CurveType>(gg_keypair.first.alpha_g1);
-                        // const g2_precomputed_type pk_g2_beta_precomp =
-                        //     precompute_g2<CurveType>(gg_keypair.first.beta_g2);
-                        //
-                        // const g1_precomputed_type proof_g1_C_precomp = precompute_g1<CurveType>(proof.g_C);
-                        // const g2_precomputed_type vk_g2_delta_precomp =
-                        //     precompute_g2<CurveType>(gg_keypair.second.delta_g2);
-                        //
-                        // const g1_precomputed_type proof_g1_cn_precomp = precompute_g1<CurveType>(acc);
-                        // const g2_precomputed_type vk_g2_gamma_precomp =
-                        //     precompute_g2<CurveType>(gg_keypair.second.gamma_g2);
-                        //
-                        // typename gt_type::value_type QAPl_1 =
-                        //     miller_loop<CurveType>(proof_g1_A_precomp, proof_g2_B_precomp);
-                        // typename gt_type::value_type QAPl_2 = double_miller_loop<CurveType>(
-                        //     proof_g1_C_precomp, vk_g2_delta_precomp, pk_g1_alpha_precomp, pk_g2_beta_precomp);
-                        //
-                        // typename gt_type::value_type QAPr_2 =
-                        //     miller_loop<CurveType>(proof_g1_cn_precomp, vk_g2_gamma_precomp);
-                        //
-                        // typename gt_type::value_type QAPl = final_exponentiation<CurveType>(QAPl_1 *
-                        // QAPl_2.inversed()); typename gt_type::value_type QAPr =
-                        // final_exponentiation<CurveType>(QAPr_2);
-
-                        bool ans2 = (QAPl == QAPr);
+                        const typename gt_type::value_type presum_cipher_miller =
+                            miller_loop<CurveType>(precompute_g1<CurveType>(*(last - 1)), processed_key.g2_one_precomp);
+                        const bool ans1 = (final_exponentiation<CurveType>(
+                                               cipher_miller * presum_cipher_miller.unitary_inversed()) ==
+                                           gt_type::value_type::one());
+
+                        const g1_precomputed_type proof_g_A_precomp = precompute_g1<CurveType>(proof.g_A);
+                        const g2_precomputed_type proof_g_B_precomp = precompute_g2<CurveType>(proof.g_B);
+                        const g1_precomputed_type proof_g_C_precomp = precompute_g1<CurveType>(proof.g_C);
+                        const g1_precomputed_type acc_precomp = precompute_g1<CurveType>(acc);
+
+                        const typename gt_type::value_type QAP1 =
+                            miller_loop<CurveType>(proof_g_A_precomp, proof_g_B_precomp);
+                        const typename gt_type::value_type QAP2 =
+                            double_miller_loop<CurveType>(acc_precomp, processed_key.gamma_g2_precomp,
+                                                          proof_g_C_precomp, processed_key.delta_g2_precomp);
+                        const bool ans2 = (final_exponentiation<CurveType>(QAP1 * QAP2.unitary_inversed()) ==
+                                           processed_key.alpha_g1_beta_g2);
 
                         return (ans1 && ans2);
                     }
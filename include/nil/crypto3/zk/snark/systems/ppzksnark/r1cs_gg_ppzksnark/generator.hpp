@@ -31,6 +31,8 @@
 #include <omp.h>
 #endif
 
+#include <memory>
+
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
 #include <nil/crypto3/algebra/multiexp/multiexp.hpp>
 #include <nil/crypto3/algebra/random_element.hpp>
@@ -79,14 +81,35 @@ namespace nil {
                     typedef typename policy_type::extended_keypair_type extended_keypair_type;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /* Make the B_query "lighter" if possible */
+                    static inline std::shared_ptr<const constraint_system_type>
+                        make_shared_constraint_system(const constraint_system_type &constraint_system) {
+                        std::shared_ptr<constraint_system_type> r1cs_copy =
+                            std::make_shared<constraint_system_type>(constraint_system);
+                        r1cs_copy->swap_AB_if_beneficial();
+
+                        return r1cs_copy;
+                    }
+
+                    /* A shared constraint system is copied only if swapping A and B pays off */
+                    static inline std::shared_ptr<const constraint_system_type>
+                        make_shared_constraint_system(
+                            const std::shared_ptr<const constraint_system_type> &constraint_system) {
+                        if (!constraint_system->is_swap_AB_beneficial()) {
+                            return constraint_system;
+                        }
+
+                        return make_shared_constraint_system(*constraint_system);
+                    }
+
                     template<typename DistributionType =
                                  boost::random::uniform_int_distribution<typename scalar_field_type::integral_type>,
-                             typename GeneratorType = boost::random::mt19937>
-                    static inline auto basic_process(const constraint_system_type &constraint_system) {
+                             typename GeneratorType = boost::random::mt19937,
+                             typename ConstraintSystem = constraint_system_type>
+                    static inline auto basic_process(const ConstraintSystem &constraint_system) {
 
-                        /* Make the B_query "lighter" if possible */
-                        constraint_system_type r1cs_copy(constraint_system);
-                        r1cs_copy.swap_AB_if_beneficial();
+                        std::shared_ptr<const constraint_system_type> r1cs_copy =
+                            make_shared_constraint_system(constraint_system);
 
                         /* Generate secret randomness */
                         const typename scalar_field_type::value_type t =
@@ -104,7 +127,7 @@ namespace nil {
 
                         /* A quadratic arithmetic program evaluated at t. */
                         qap_instance_evaluation<scalar_field_type> qap =
-                            reductions::r1cs_to_qap<scalar_field_type>::instance_map_with_evaluation(r1cs_copy, t);
+                            reductions::r1cs_to_qap<scalar_field_type>::instance_map_with_evaluation(*r1cs_copy, t);
 
                         std::size_t non_zero_At = 0;
                         std::size_t non_zero_Bt = 0;
@@ -234,13 +257,19 @@ namespace nil {
                                                std::move(gamma_ABC_g1), std::move(gamma_g1));
                     }
 
+                    /*
+                     * The constraint system may be given either by value or as
+                     * std::shared_ptr<const constraint_system_type>; in the latter case keys generated for the
+                     * same circuit reference a single copy of it.
+                     */
                     template<typename KeyPairType,
                              typename DistributionType =
                                  boost::random::uniform_int_distribution<typename scalar_field_type::integral_type>,
-                             typename GeneratorType = boost::random::mt19937>
+                             typename GeneratorType = boost::random::mt19937,
+                             typename ConstraintSystem = constraint_system_type>
                     static inline
                         typename std::enable_if<std::is_same<keypair_type, KeyPairType>::value, KeyPairType>::type
-                        process(const constraint_system_type &constraint_system) {
+                        process(const ConstraintSystem &constraint_system) {
 
                         auto [alpha_g1, beta_g1, beta_g2, delta_g1, delta_g2, gamma_g2, A_query, B_query, H_query,
                               L_query, r1cs_copy, alpha_g1_beta_g2, gamma_ABC_g1, gamma_g1] =
@@ -266,10 +295,11 @@ namespace nil {
                     template<typename KeyPairType,
                              typename DistributionType =
                                  boost::random::uniform_int_distribution<typename scalar_field_type::integral_type>,
-                             typename GeneratorType = boost::random::mt19937>
+                             typename GeneratorType = boost::random::mt19937,
+                             typename ConstraintSystem = constraint_system_type>
                     static inline typename std::enable_if<std::is_same<extended_keypair_type, KeyPairType>::value,
                                                           KeyPairType>::type
-                        process(const constraint_system_type &constraint_system) {
+                        process(const ConstraintSystem &constraint_system) {
 
                         auto [alpha_g1, beta_g1, beta_g2, delta_g1, delta_g2, gamma_g2, A_query, B_query, H_query,
                               L_query, r1cs_copy, alpha_g1_beta_g2, gamma_ABC_g1, gamma_g1] =
@@ -56,9 +56,20 @@
 #ifndef CRYPTO3_MARSHALLING_R1CS_GG_PPZKSNARK_TYPES_HPP
 #define CRYPTO3_MARSHALLING_R1CS_GG_PPZKSNARK_TYPES_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <tuple>
 
+#include <boost/crc.hpp>
+
 #include <nil/crypto3/multiprecision/number.hpp>
 #include <nil/crypto3/multiprecision/cpp_int.hpp>
 #include <nil/crypto3/multiprecision/modular/modular_adaptor.hpp>
@@ -167,6 +178,33 @@ namespace nil {
                 return std::get<1>(processed);
             }
 
+            /*
+             * Whether [read_iter_begin, read_iter_end) holds count records of record_size bytes after prefix_size
+             * bytes. count comes from an untrusted length prefix, so it is compared against the available size
+             * divided by record_size rather than multiplied, which could wrap around.
+             */
+            static inline bool has_records(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                           typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                           std::size_t prefix_size,
+                                           std::size_t count,
+                                           std::size_t record_size) {
+                const std::size_t available = std::distance(read_iter_begin, read_iter_end);
+
+                return available >= prefix_size && count <= (available - prefix_size) / record_size;
+            }
+
+            /*
+             * A decompressed point is accepted only if it lies on the curve and in the prime order subgroup,
+             * the latter checked as r * P = 0 for the scalar field modulus r.
+             */
+            template<typename GroupType>
+            static inline bool group_element_is_valid(const typename GroupType::value_type &point) {
+                using integral_type = typename CurveType::scalar_field_type::integral_type;
+
+                return point.is_well_formed() &&
+                       (integral_type(CurveType::scalar_field_type::modulus) * point).is_zero();
+            }
+
             template<typename GroupType>
             static inline typename GroupType::value_type
                 g1_group_type_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
@@ -181,7 +219,22 @@ namespace nil {
                     input_array[i] = read_iter_begin[i];
                 }
 
-                return curve_element_serializer<CurveType>::octets_to_g1_point(input_array);
+                typename GroupType::value_type point;
+                try {
+                    point = curve_element_serializer<CurveType>::octets_to_g1_point(input_array);
+                } catch (...) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return GroupType::value_type::zero();
+                }
+
+                if (!group_element_is_valid<GroupType>(point)) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return GroupType::value_type::zero();
+                }
+
+                return point;
             }
 
             template<typename GroupType>
@@ -198,7 +251,129 @@ namespace nil {
                     input_array[i] = read_iter_begin[i];
                 }
 
-                return curve_element_serializer<CurveType>::octets_to_g2_point(input_array);
+                typename GroupType::value_type point;
+                try {
+                    point = curve_element_serializer<CurveType>::octets_to_g2_point(input_array);
+                } catch (...) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return GroupType::value_type::zero();
+                }
+
+                if (!group_element_is_valid<GroupType>(point)) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return GroupType::value_type::zero();
+                }
+
+                return point;
+            }
+
+            /*
+             * Points are stored compressed, so recovering each of them costs a square root in the base
+             * field (and in Fp2 for G2). Points of a query vector are independent, hence the batch
+             * variants below decompress them in parallel chunks.
+             */
+            template<typename GroupType, typename OutputIterator>
+            static inline void g1_group_type_batch_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                           typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                                           std::size_t count,
+                                                           OutputIterator write_iter,
+                                                           status_type &processingStatus) {
+
+                processingStatus = status_type::success;
+
+                if (!has_records(read_iter_begin, read_iter_end, 0, count, g1_byteblob_size)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return;
+                }
+
+                std::atomic<bool> is_valid(true);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    status_type point_status = status_type::success;
+
+                    write_iter[i] = g1_group_type_process<GroupType>(read_iter_begin + i * g1_byteblob_size,
+                                                                     read_iter_begin + (i + 1) * g1_byteblob_size,
+                                                                     point_status);
+
+                    if (point_status != status_type::success) {
+                        is_valid = false;
+                    }
+                }
+
+                if (!is_valid) {
+                    processingStatus = status_type::invalid_msg_data;
+                }
+            }
+
+            template<typename GroupType>
+            static inline std::vector<typename GroupType::value_type>
+                g1_group_type_batch_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                            typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                            std::size_t count,
+                                            status_type &processingStatus) {
+
+                if (!has_records(read_iter_begin, read_iter_end, 0, count, g1_byteblob_size)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return std::vector<typename GroupType::value_type>();
+                }
+
+                std::vector<typename GroupType::value_type> result(count);
+
+                g1_group_type_batch_process<GroupType>(read_iter_begin, read_iter_end, count, result.begin(),
+                                                       processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return std::vector<typename GroupType::value_type>();
+                }
+
+                return result;
+            }
+
+            template<typename GroupType, typename OutputIterator>
+            static inline void g2_group_type_batch_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                           typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                                           std::size_t count,
+                                                           OutputIterator write_iter,
+                                                           status_type &processingStatus) {
+
+                processingStatus = status_type::success;
+
+                if (!has_records(read_iter_begin, read_iter_end, 0, count, g2_byteblob_size)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return;
+                }
+
+                std::atomic<bool> is_valid(true);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    status_type point_status = status_type::success;
+
+                    write_iter[i] = g2_group_type_process<GroupType>(read_iter_begin + i * g2_byteblob_size,
+                                                                     read_iter_begin + (i + 1) * g2_byteblob_size,
+                                                                     point_status);
+
+                    if (point_status != status_type::success) {
+                        is_valid = false;
+                    }
+                }
+
+                if (!is_valid) {
+                    processingStatus = status_type::invalid_msg_data;
+                }
             }
 
             static inline linear_term<typename CurveType::scalar_field_type>
@@ -383,6 +558,72 @@ namespace nil {
                     g, h);
             }
 
+            template<typename OutputIterator>
+            static inline void g2g1_element_kc_batch_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                             typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                                             std::size_t count,
+                                                             OutputIterator write_iter,
+                                                             status_type &processingStatus) {
+
+                processingStatus = status_type::success;
+
+                if (!has_records(read_iter_begin, read_iter_end, 0, count, g2g1_element_kc_byteblob_size)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return;
+                }
+
+                std::atomic<bool> is_valid(true);
+
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    status_type point_status = status_type::success;
+
+                    write_iter[i] = g2g1_element_kc_process(read_iter_begin + i * g2g1_element_kc_byteblob_size,
+                                                            read_iter_begin + (i + 1) * g2g1_element_kc_byteblob_size,
+                                                            point_status);
+
+                    if (point_status != status_type::success) {
+                        is_valid = false;
+                    }
+                }
+
+                if (!is_valid) {
+                    processingStatus = status_type::invalid_msg_data;
+                }
+            }
+
+            static inline std::vector<crypto3::zk::snark::detail::element_kc<typename CurveType::template g2_type<>,
+                                                                             typename CurveType::template g1_type<>>>
+                g2g1_element_kc_batch_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                              typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                              std::size_t count,
+                                              status_type &processingStatus) {
+
+                using element_kc_type = crypto3::zk::snark::detail::element_kc<typename CurveType::template g2_type<>,
+                                                                               typename CurveType::template g1_type<>>;
+
+                if (!has_records(read_iter_begin, read_iter_end, 0, count, g2g1_element_kc_byteblob_size)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return std::vector<element_kc_type>();
+                }
+
+                std::vector<element_kc_type> result(count);
+
+                g2g1_element_kc_batch_process(read_iter_begin, read_iter_end, count, result.begin(), processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return std::vector<element_kc_type>();
+                }
+
+                return result;
+            }
+
             static inline knowledge_commitment_vector<typename CurveType::template g2_type<>, typename CurveType::template g1_type<>>
                 g2g1_knowledge_commitment_vector_process(
                     typename std::vector<chunk_type>::const_iterator read_iter_begin,
@@ -405,6 +646,14 @@ namespace nil {
                     return sparse_vector<T>();
                 }
 
+                if (!has_records(read_iter_begin, read_iter_end, 2 * std_size_t_byteblob_size, indices_count,
+                                 std_size_t_byteblob_size + g2g1_element_kc_byteblob_size)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return sparse_vector<T>();
+                }
+
                 std::vector<std::size_t> indices(indices_count, 0);
 
                 for (std::size_t i = 0; i < indices_count; i++) {
@@ -417,18 +666,13 @@ namespace nil {
                     }
                 }
 
-                std::vector<typename T::value_type> values(indices_count);
-
-                for (std::size_t i = 0; i < indices_count; i++) {
-                    values[i] = g2g1_element_kc_process(
-                        read_iter_begin + std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size +
-                            i * g2g1_element_kc_byteblob_size,
-                        read_iter_begin + std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size +
-                            (i + 1) * g2g1_element_kc_byteblob_size,
-                        processingStatus);
-                    if (processingStatus != status_type::success) {
-                        return sparse_vector<T>();
-                    }
+                std::vector<typename T::value_type> values = g2g1_element_kc_batch_process(
+                    read_iter_begin + std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size,
+                    read_iter_end,
+                    indices_count,
+                    processingStatus);
+                if (processingStatus != status_type::success) {
+                    return sparse_vector<T>();
                 }
 
                 std::size_t domain_size_ = std_size_t_process(
@@ -501,9 +745,8 @@ namespace nil {
                     return sparse_vector<T>();
                 }
 
-                if (std::distance(read_iter_begin, read_iter_end) <
-                    std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size +
-                        indices_count * g1_byteblob_size + std_size_t_byteblob_size) {
+                if (!has_records(read_iter_begin, read_iter_end, 2 * std_size_t_byteblob_size, indices_count,
+                                 std_size_t_byteblob_size + g1_byteblob_size)) {
 
                     processingStatus = status_type::not_enough_data;
 
@@ -522,18 +765,13 @@ namespace nil {
                     }
                 }
 
-                std::vector<typename T::value_type> values(indices_count);
-
-                for (std::size_t i = 0; i < indices_count; i++) {
-                    values[i] = g1_group_type_process<T>(
-                        read_iter_begin + std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size +
-                            i * g1_byteblob_size,
-                        read_iter_begin + std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size +
-                            (i + 1) * g1_byteblob_size,
-                        processingStatus);
-                    if (processingStatus != status_type::success) {
-                        return sparse_vector<T>();
-                    }
+                std::vector<typename T::value_type> values = g1_group_type_batch_process<T>(
+                    read_iter_begin + std_size_t_byteblob_size + indices_count * std_size_t_byteblob_size,
+                    read_iter_end,
+                    indices_count,
+                    processingStatus);
+                if (processingStatus != status_type::success) {
+                    return sparse_vector<T>();
                 }
 
                 std::size_t domain_size_ = std_size_t_process(
@@ -609,22 +847,21 @@ namespace nil {
                     return typename scheme_type::verification_key_type();
                 }
 
-                typename CurveType::template g2_type<>::value_type gamma_g2 = g2_group_type_process<typename CurveType::template g2_type<>>(
+                /* gamma_g2 and delta_g2 */
+                std::array<typename CurveType::template g2_type<>::value_type, 2> g2_points;
+                g2_group_type_batch_process<typename CurveType::template g2_type<>>(
                     read_iter_begin + gt_byteblob_size,
-                    read_iter_begin + gt_byteblob_size + g2_byteblob_size,
-                    processingStatus);
-                if (processingStatus != status_type::success) {
-                    return typename scheme_type::verification_key_type();
-                }
-
-                typename CurveType::template g2_type<>::value_type delta_g2 = g2_group_type_process<typename CurveType::template g2_type<>>(
-                    read_iter_begin + gt_byteblob_size + g2_byteblob_size,
                     read_iter_begin + gt_byteblob_size + g2_byteblob_size + g2_byteblob_size,
+                    g2_points.size(),
+                    g2_points.begin(),
                     processingStatus);
                 if (processingStatus != status_type::success) {
                     return typename scheme_type::verification_key_type();
                 }
 
+                const typename CurveType::template g2_type<>::value_type &gamma_g2 = g2_points[0];
+                const typename CurveType::template g2_type<>::value_type &delta_g2 = g2_points[1];
+
                 accumulation_vector<typename CurveType::template g1_type<>> gamma_ABC_g1 =
                     g1_accumulation_vector_process<typename CurveType::template g1_type<>>(read_iter_begin + gt_byteblob_size +
                                                                                     g2_byteblob_size + g2_byteblob_size,
@@ -648,28 +885,44 @@ namespace nil {
                 typename CurveType::template g1_type<>::value_type alpha_g1 = g1_group_type_process<typename CurveType::template g1_type<>>(
                     read_iter_current_begin, read_iter_current_begin + g1_byteblob_size, processingStatus);
                 read_iter_current_begin += g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
                 typename CurveType::template g1_type<>::value_type beta_g1 = g1_group_type_process<typename CurveType::template g1_type<>>(
                     read_iter_current_begin, read_iter_current_begin + g1_byteblob_size, processingStatus);
                 read_iter_current_begin += g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
                 typename CurveType::template g2_type<>::value_type beta_g2 = g2_group_type_process<typename CurveType::template g2_type<>>(
                     read_iter_current_begin, read_iter_current_begin + g2_byteblob_size, processingStatus);
                 read_iter_current_begin += g2_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
                 typename CurveType::template g1_type<>::value_type delta_g1 = g1_group_type_process<typename CurveType::template g1_type<>>(
                     read_iter_current_begin, read_iter_current_begin + g1_byteblob_size, processingStatus);
                 read_iter_current_begin += g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
                 typename CurveType::template g2_type<>::value_type delta_g2 = g2_group_type_process<typename CurveType::template g2_type<>>(
                     read_iter_current_begin, read_iter_current_begin + g2_byteblob_size, processingStatus);
                 read_iter_current_begin += g2_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
                 std::size_t A_query_size = std_size_t_process(
                     read_iter_current_begin, read_iter_current_begin + std_size_t_byteblob_size, processingStatus);
 
                 read_iter_current_begin += std_size_t_byteblob_size;
-                std::vector<typename CurveType::template g1_type<>::value_type> A_query(A_query_size);
+                std::vector<typename CurveType::template g1_type<>::value_type> A_query =
+                    g1_group_type_batch_process<typename CurveType::template g1_type<>>(
+                        read_iter_current_begin, read_iter_end, A_query_size, processingStatus);
+                read_iter_current_begin += A_query_size * g1_byteblob_size;
 
-                for (std::size_t i = 0; i < A_query_size; ++i) {
-                    A_query[i] = g1_group_type_process<typename CurveType::template g1_type<>>(
-                        read_iter_current_begin, read_iter_current_begin + g1_byteblob_size, processingStatus);
-                    read_iter_current_begin += g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
                 }
 
                 std::size_t total_B_query_size = std_size_t_process(
@@ -687,24 +940,26 @@ namespace nil {
                     read_iter_current_begin, read_iter_current_begin + std_size_t_byteblob_size, processingStatus);
 
                 read_iter_current_begin += std_size_t_byteblob_size;
-                std::vector<typename CurveType::template g1_type<>::value_type> H_query(H_query_size);
+                std::vector<typename CurveType::template g1_type<>::value_type> H_query =
+                    g1_group_type_batch_process<typename CurveType::template g1_type<>>(
+                        read_iter_current_begin, read_iter_end, H_query_size, processingStatus);
+                read_iter_current_begin += H_query_size * g1_byteblob_size;
 
-                for (std::size_t i = 0; i < H_query_size; ++i) {
-                    H_query[i] = g1_group_type_process<typename CurveType::template g1_type<>>(
-                        read_iter_current_begin, read_iter_current_begin + g1_byteblob_size, processingStatus);
-                    read_iter_current_begin += g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
                 }
 
                 std::size_t L_query_size = std_size_t_process(
                     read_iter_current_begin, read_iter_current_begin + std_size_t_byteblob_size, processingStatus);
 
                 read_iter_current_begin += std_size_t_byteblob_size;
-                std::vector<typename CurveType::template g1_type<>::value_type> L_query(L_query_size);
+                std::vector<typename CurveType::template g1_type<>::value_type> L_query =
+                    g1_group_type_batch_process<typename CurveType::template g1_type<>>(
+                        read_iter_current_begin, read_iter_end, L_query_size, processingStatus);
+                read_iter_current_begin += L_query_size * g1_byteblob_size;
 
-                for (std::size_t i = 0; i < L_query_size; ++i) {
-                    L_query[i] = g1_group_type_process<typename CurveType::template g1_type<>>(
-                        read_iter_current_begin, read_iter_current_begin + g1_byteblob_size, processingStatus);
-                    read_iter_current_begin += g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
                 }
 
                 r1cs_constraint_system<typename CurveType::scalar_field_type> constraint_system =
@@ -735,8 +990,7 @@ namespace nil {
                     return typename scheme_type::primary_input_type();
                 }
 
-                if (std::distance(read_iter_begin, read_iter_end) <
-                    std_size_t_byteblob_size + pi_count * fr_byteblob_size) {
+                if (!has_records(read_iter_begin, read_iter_end, std_size_t_byteblob_size, pi_count, fr_byteblob_size)) {
 
                     processingStatus = status_type::not_enough_data;
 
@@ -772,30 +1026,44 @@ namespace nil {
                     return typename scheme_type::proof_type();
                 }
 
-                typename CurveType::template g1_type<>::value_type g_A = g1_group_type_process<typename CurveType::template g1_type<>>(
-                    read_iter_begin, read_iter_begin + g1_byteblob_size, processingStatus);
-
-                if (processingStatus != status_type::success) {
-                    return typename scheme_type::proof_type();
-                }
-
-                typename CurveType::template g2_type<>::value_type g_B = g2_group_type_process<typename CurveType::template g2_type<>>(
-                    read_iter_begin + g1_byteblob_size,
-                    read_iter_begin + g1_byteblob_size + g2_byteblob_size,
-                    processingStatus);
+                /* the three points are independent, decompress and check them concurrently */
+                typename CurveType::template g1_type<>::value_type g_A, g_C;
+                typename CurveType::template g2_type<>::value_type g_B;
+                status_type g_A_status, g_B_status, g_C_status;
+
+#ifdef MULTICORE
+#pragma omp parallel sections
+#endif
+                {
+#ifdef MULTICORE
+#pragma omp section
+#endif
+                    g_A = g1_group_type_process<typename CurveType::template g1_type<>>(
+                        read_iter_begin, read_iter_begin + g1_byteblob_size, g_A_status);
+#ifdef MULTICORE
+#pragma omp section
+#endif
+                    g_B = g2_group_type_process<typename CurveType::template g2_type<>>(
+                        read_iter_begin + g1_byteblob_size,
+                        read_iter_begin + g1_byteblob_size + g2_byteblob_size,
+                        g_B_status);
+#ifdef MULTICORE
+#pragma omp section
+#endif
+                    g_C = g1_group_type_process<typename CurveType::template g1_type<>>(
+                        read_iter_begin + g1_byteblob_size + g2_byteblob_size,
+                        read_iter_begin + g1_byteblob_size + g2_byteblob_size + g1_byteblob_size,
+                        g_C_status);
+                }
+
+                if (g_A_status != status_type::success || g_B_status != status_type::success ||
+                    g_C_status != status_type::success) {
+                    processingStatus = status_type::invalid_msg_data;
 
-                if (processingStatus != status_type::success) {
                     return typename scheme_type::proof_type();
                 }
 
-                typename CurveType::template g1_type<>::value_type g_C = g1_group_type_process<typename CurveType::template g1_type<>>(
-                    read_iter_begin + g1_byteblob_size + g2_byteblob_size,
-                    read_iter_begin + g1_byteblob_size + g2_byteblob_size + g1_byteblob_size,
-                    processingStatus);
-
-                if (processingStatus != status_type::success) {
-                    return typename scheme_type::proof_type();
-                }
+                processingStatus = status_type::success;
 
                 return typename scheme_type::proof_type(std::move(g_A), std::move(g_B), std::move(g_C));
             }
@@ -865,6 +1133,359 @@ namespace nil {
             }
         };
 
+        template<typename ProofSystem>
+        struct proving_key_stream_deserializer_tvm;
+
+        /*
+         * Incremental counterpart of verifier_input_deserializer_tvm::proving_key_process.
+         *
+         * The serialized proving key may be supplied in chunks of arbitrary size (e.g. as it is read
+         * from a file or a socket). Query vectors and the constraint system are sized from their length
+         * prefixes and filled in place, so apart from the key itself only a bounded slice of the input
+         * and an unfinished record are kept in memory.
+         */
+        template<>
+        struct proving_key_stream_deserializer_tvm<
+            nil::crypto3::zk::snark::r1cs_gg_ppzksnark<algebra::curves::bls12<381>>> {
+
+            using CurveType = typename algebra::curves::bls12<381>;
+            using scheme_type = nil::crypto3::zk::snark::r1cs_gg_ppzksnark<CurveType>;
+            using deserializer_type = verifier_input_deserializer_tvm<scheme_type>;
+
+            using chunk_type = typename deserializer_type::chunk_type;
+            using proving_key_type = typename scheme_type::proving_key_type;
+            using constraint_system_type = typename proving_key_type::constraint_system_type;
+
+            using g1_type = typename CurveType::template g1_type<>;
+            using g2_type = typename CurveType::template g2_type<>;
+
+            proving_key_stream_deserializer_tvm() :
+                state(state_type::alpha_g1), status(status_type::success), position(0), count(0) {
+            }
+
+            /*
+             * Consumes the next chunk of the serialized key. Returns status_type::success as long as the
+             * data seen so far is well-formed; use is_complete() to find out whether the key is finished.
+             * Bytes following a complete key are ignored.
+             *
+             * The first malformed record is latched: this and every later call return its status without
+             * consuming any more input, so a corrupt key is never reported as complete.
+             *
+             * The chunk is buffered in slices of at most max_slice_size bytes, and the complete records of
+             * a slice are parsed and dropped from the buffer before the next slice is appended, so the
+             * buffer holds at most one slice and an unfinished record whatever the size of the chunk.
+             */
+            template<typename InputIterator>
+            status_type process(InputIterator first, InputIterator last) {
+
+                while (status == status_type::success && state != state_type::done && first != last) {
+                    for (std::size_t i = 0; i < max_slice_size && first != last; ++i, ++first) {
+                        buffer.push_back(*first);
+                    }
+
+                    typename std::vector<chunk_type>::const_iterator read_iter = buffer.cbegin();
+                    while (state != state_type::done && step(read_iter, status) && status == status_type::success) {
+                    }
+                    buffer.erase(buffer.cbegin(), read_iter);
+                }
+
+                if (status != status_type::success || state == state_type::done) {
+                    std::vector<chunk_type>().swap(buffer);
+                }
+
+                return status;
+            }
+
+            bool is_complete() const {
+                return state == state_type::done;
+            }
+
+            /*
+             * Moves the deserialized key out. Must only be called once is_complete() holds.
+             */
+            proving_key_type result() {
+                BOOST_ASSERT(is_complete());
+
+                proving_key.constraint_system =
+                    std::make_shared<const constraint_system_type>(std::move(constraint_system));
+
+                return std::move(proving_key);
+            }
+
+        private:
+            enum class state_type {
+                alpha_g1,
+                beta_g1,
+                beta_g2,
+                delta_g1,
+                delta_g2,
+                A_query_size,
+                A_query,
+                B_query_byteblob_size,
+                B_query_indices_count,
+                B_query_indices,
+                B_query_values,
+                B_query_domain_size,
+                H_query_size,
+                H_query,
+                L_query_size,
+                L_query,
+                primary_input_size,
+                auxiliary_input_size,
+                constraints_count,
+                constraints,
+                done
+            };
+
+            std::size_t available(typename std::vector<chunk_type>::const_iterator read_iter) const {
+                return std::distance(read_iter, buffer.cend());
+            }
+
+            std::size_t size_t_process(typename std::vector<chunk_type>::const_iterator &read_iter,
+                                       status_type &processingStatus) {
+                std::size_t result = deserializer_type::std_size_t_process(
+                    read_iter, read_iter + deserializer_type::std_size_t_byteblob_size, processingStatus);
+                read_iter += deserializer_type::std_size_t_byteblob_size;
+
+                return result;
+            }
+
+            void g1_vector_size_process(std::vector<typename g1_type::value_type> &query,
+                                        typename std::vector<chunk_type>::const_iterator &read_iter,
+                                        status_type &processingStatus,
+                                        state_type next) {
+                count = size_t_process(read_iter, processingStatus);
+                position = 0;
+                query.resize(count);
+                state = count ? next : static_cast<state_type>(static_cast<int>(next) + 1);
+            }
+
+            bool g1_vector_process(std::vector<typename g1_type::value_type> &query,
+                                   typename std::vector<chunk_type>::const_iterator &read_iter,
+                                   status_type &processingStatus,
+                                   state_type next) {
+                std::size_t ready = std::min(count - position, available(read_iter) / deserializer_type::g1_byteblob_size);
+
+                if (!ready) {
+                    return false;
+                }
+
+                deserializer_type::g1_group_type_batch_process<g1_type>(
+                    read_iter, buffer.cend(), ready, query.begin() + position, processingStatus);
+                read_iter += ready * deserializer_type::g1_byteblob_size;
+                position += ready;
+
+                if (position == count) {
+                    state = next;
+                }
+
+                return true;
+            }
+
+            bool step(typename std::vector<chunk_type>::const_iterator &read_iter, status_type &processingStatus) {
+
+                constexpr const std::size_t size_t_size = deserializer_type::std_size_t_byteblob_size;
+
+                switch (state) {
+                    case state_type::alpha_g1:
+                    case state_type::beta_g1:
+                    case state_type::delta_g1: {
+                        if (available(read_iter) < deserializer_type::g1_byteblob_size) {
+                            return false;
+                        }
+
+                        typename g1_type::value_type &point =
+                            state == state_type::alpha_g1 ?
+                                proving_key.alpha_g1 :
+                                (state == state_type::beta_g1 ? proving_key.beta_g1 : proving_key.delta_g1);
+                        point = deserializer_type::g1_group_type_process<g1_type>(
+                            read_iter, read_iter + deserializer_type::g1_byteblob_size, processingStatus);
+                        read_iter += deserializer_type::g1_byteblob_size;
+                        state = static_cast<state_type>(static_cast<int>(state) + 1);
+
+                        return true;
+                    }
+                    case state_type::beta_g2:
+                    case state_type::delta_g2: {
+                        if (available(read_iter) < deserializer_type::g2_byteblob_size) {
+                            return false;
+                        }
+
+                        typename g2_type::value_type &point =
+                            state == state_type::beta_g2 ? proving_key.beta_g2 : proving_key.delta_g2;
+                        point = deserializer_type::g2_group_type_process<g2_type>(
+                            read_iter, read_iter + deserializer_type::g2_byteblob_size, processingStatus);
+                        read_iter += deserializer_type::g2_byteblob_size;
+                        state = static_cast<state_type>(static_cast<int>(state) + 1);
+
+                        return true;
+                    }
+                    case state_type::A_query_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        g1_vector_size_process(proving_key.A_query, read_iter, processingStatus, state_type::A_query);
+
+                        return true;
+                    case state_type::A_query:
+                        return g1_vector_process(proving_key.A_query, read_iter, processingStatus,
+                                                 state_type::B_query_byteblob_size);
+                    case state_type::B_query_byteblob_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        // The total byteblob size of B_query is only needed by the one-shot deserializer.
+                        size_t_process(read_iter, processingStatus);
+                        state = state_type::B_query_indices_count;
+
+                        return true;
+                    case state_type::B_query_indices_count:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        count = size_t_process(read_iter, processingStatus);
+                        position = 0;
+                        proving_key.B_query.indices.resize(count);
+                        proving_key.B_query.values.resize(count);
+                        state = count ? state_type::B_query_indices : state_type::B_query_domain_size;
+
+                        return true;
+                    case state_type::B_query_indices: {
+                        std::size_t ready = std::min(count - position, available(read_iter) / size_t_size);
+
+                        if (!ready) {
+                            return false;
+                        }
+
+                        for (std::size_t i = 0; i < ready && processingStatus == status_type::success; ++i) {
+                            proving_key.B_query.indices[position++] = size_t_process(read_iter, processingStatus);
+                        }
+
+                        if (position == count) {
+                            position = 0;
+                            state = state_type::B_query_values;
+                        }
+
+                        return true;
+                    }
+                    case state_type::B_query_values: {
+                        std::size_t ready = std::min(
+                            count - position, available(read_iter) / deserializer_type::g2g1_element_kc_byteblob_size);
+
+                        if (!ready) {
+                            return false;
+                        }
+
+                        deserializer_type::g2g1_element_kc_batch_process(read_iter, buffer.cend(), ready,
+                                                                         proving_key.B_query.values.begin() + position,
+                                                                         processingStatus);
+                        read_iter += ready * deserializer_type::g2g1_element_kc_byteblob_size;
+                        position += ready;
+
+                        if (position == count) {
+                            state = state_type::B_query_domain_size;
+                        }
+
+                        return true;
+                    }
+                    case state_type::B_query_domain_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        proving_key.B_query.domain_size_ = size_t_process(read_iter, processingStatus);
+                        state = state_type::H_query_size;
+
+                        return true;
+                    case state_type::H_query_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        g1_vector_size_process(proving_key.H_query, read_iter, processingStatus, state_type::H_query);
+
+                        return true;
+                    case state_type::H_query:
+                        return g1_vector_process(proving_key.H_query, read_iter, processingStatus,
+                                                 state_type::L_query_size);
+                    case state_type::L_query_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        g1_vector_size_process(proving_key.L_query, read_iter, processingStatus, state_type::L_query);
+
+                        return true;
+                    case state_type::L_query:
+                        return g1_vector_process(proving_key.L_query, read_iter, processingStatus,
+                                                 state_type::primary_input_size);
+                    case state_type::primary_input_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        constraint_system.primary_input_size = size_t_process(read_iter, processingStatus);
+                        state = state_type::auxiliary_input_size;
+
+                        return true;
+                    case state_type::auxiliary_input_size:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        constraint_system.auxiliary_input_size = size_t_process(read_iter, processingStatus);
+                        state = state_type::constraints_count;
+
+                        return true;
+                    case state_type::constraints_count:
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+                        count = size_t_process(read_iter, processingStatus);
+                        position = 0;
+                        constraint_system.constraints.reserve(count);
+                        state = count ? state_type::constraints : state_type::done;
+
+                        return true;
+                    case state_type::constraints: {
+                        if (available(read_iter) < size_t_size) {
+                            return false;
+                        }
+
+                        // Each constraint is prefixed with its byteblob size, so it is parsed only once it
+                        // is available as a whole.
+                        std::size_t constraint_byteblob_size =
+                            deserializer_type::std_size_t_process(read_iter, read_iter + size_t_size, processingStatus);
+
+                        if (processingStatus != status_type::success ||
+                            available(read_iter) < size_t_size + constraint_byteblob_size) {
+                            return false;
+                        }
+
+                        read_iter += size_t_size;
+                        constraint_system.constraints.emplace_back(
+                            deserializer_type::r1cs_constraint_process(
+                                read_iter, read_iter + constraint_byteblob_size, processingStatus));
+                        read_iter += constraint_byteblob_size;
+
+                        if (++position == count) {
+                            state = state_type::done;
+                        }
+
+                        return true;
+                    }
+                    default:
+                        return false;
+                }
+            }
+
+            constexpr static const std::size_t max_slice_size = 1 << 16;
+
+            state_type state;
+            status_type status;
+            std::size_t position;
+            std::size_t count;
+
+            std::vector<chunk_type> buffer;
+            proving_key_type proving_key;
+            constraint_system_type constraint_system;
+        };
+
         template<typename ProofSystem>
         struct verifier_input_serializer_tvm;
 
@@ -892,7 +1513,7 @@ namespace nil {
             template<typename FieldType>
             static inline
                 typename std::enable_if<!::nil::crypto3::algebra::is_extended_field<FieldType>::value, void>::type
-                field_type_process(typename FieldType::value_type input_fp,
+                field_type_process(const typename FieldType::value_type &input_fp,
                                    typename std::vector<chunk_type>::iterator &write_iter) {
 
                 typedef nil::crypto3::multiprecision::number<nil::crypto3::multiprecision::backends::cpp_int_backend<>>
@@ -923,7 +1544,7 @@ namespace nil {
             }
 
             template<typename GroupType>
-            static inline void g1_group_type_process(typename GroupType::value_type input_g,
+            static inline void g1_group_type_process(const typename GroupType::value_type &input_g,
                                                      typename std::vector<chunk_type>::iterator &write_iter) {
 
                 auto compressed_curve_group_element =
@@ -935,7 +1556,7 @@ namespace nil {
             }
 
             template<typename GroupType>
-            static inline void g2_group_type_process(typename GroupType::value_type input_g,
+            static inline void g2_group_type_process(const typename GroupType::value_type &input_g,
                                                      typename std::vector<chunk_type>::iterator &write_iter) {
 
                 auto compressed_curve_group_element =
@@ -959,7 +1580,7 @@ namespace nil {
             }
 
             template<typename T>
-            static inline void g1_sparse_vector_process(sparse_vector<T> input_sv,
+            static inline void g1_sparse_vector_process(const sparse_vector<T> &input_sv,
                                                         std::vector<chunk_type>::iterator &write_iter) {
 
                 std::size_t ic_size = input_sv.values.size();
@@ -984,7 +1605,7 @@ namespace nil {
             }
 
             template<typename T>
-            static inline void g1_accumulation_vector_process(accumulation_vector<T> input_av,
+            static inline void g1_accumulation_vector_process(const accumulation_vector<T> &input_av,
                                                               std::vector<chunk_type>::iterator &write_iter) {
 
                 g1_group_type_process<typename CurveType::template g1_type<>>(input_av.first, write_iter);
@@ -993,7 +1614,7 @@ namespace nil {
             }
 
             template<typename T>
-            static inline void linear_term_process(linear_term<T> input_lt,
+            static inline void linear_term_process(const linear_term<T> &input_lt,
                                                    std::vector<chunk_type>::iterator &write_iter) {
 
                 std_size_t_process(input_lt.index, write_iter);
@@ -1002,7 +1623,7 @@ namespace nil {
             }
 
             template<typename T>
-            static inline void linear_combination_process(linear_combination<T> input_cm,
+            static inline void linear_combination_process(const linear_combination<T> &input_cm,
                                                           std::vector<chunk_type>::iterator &write_iter) {
 
                 std_size_t_process(input_cm.terms.size(), write_iter);
@@ -1013,7 +1634,7 @@ namespace nil {
             }
 
             static inline std::size_t
-                get_r1cs_constraint_byteblob_size(r1cs_constraint<typename CurveType::scalar_field_type> input_rc) {
+                get_r1cs_constraint_byteblob_size(const r1cs_constraint<typename CurveType::scalar_field_type> &input_rc) {
 
                 return input_rc.a.terms.size() * (std_size_t_byteblob_size + fr_byteblob_size) +
                        std_size_t_byteblob_size +
@@ -1024,7 +1645,7 @@ namespace nil {
             }
 
             template<typename T>
-            static inline void r1cs_constraint_process(r1cs_constraint<T> input_rc,
+            static inline void r1cs_constraint_process(const r1cs_constraint<T> &input_rc,
                                                        std::vector<chunk_type>::iterator &write_iter) {
 
                 std_size_t_process(get_r1cs_constraint_byteblob_size(input_rc), write_iter);
@@ -1034,7 +1655,7 @@ namespace nil {
             }
 
             template<typename T>
-            static inline void r1cs_constraint_system_process(r1cs_constraint_system<T> input_rs,
+            static inline void r1cs_constraint_system_process(const r1cs_constraint_system<T> &input_rs,
                                                               std::vector<chunk_type>::iterator &write_iter) {
 
                 std_size_t_process(input_rs.primary_input_size, write_iter);
@@ -1047,8 +1668,8 @@ namespace nil {
             }
 
             static inline void g2g1_element_kc_process(
-                crypto3::zk::snark::detail::element_kc<typename CurveType::template g2_type<>, typename CurveType::template g1_type<>>
-                    input_ek,
+                const crypto3::zk::snark::detail::element_kc<typename CurveType::template g2_type<>,
+                                                             typename CurveType::template g1_type<>> &input_ek,
                 std::vector<chunk_type>::iterator &write_iter) {
 
                 g2_group_type_process<typename CurveType::template g2_type<>>(input_ek.g, write_iter);
@@ -1056,15 +1677,16 @@ namespace nil {
             }
 
             static inline std::size_t get_g2g1_knowledge_commitment_vector_size(
-                knowledge_commitment_vector<typename CurveType::template g2_type<>, typename CurveType::template g1_type<>> input_kv) {
+                const knowledge_commitment_vector<typename CurveType::template g2_type<>,
+                                                  typename CurveType::template g1_type<>> &input_kv) {
 
                 return (2 + input_kv.indices.size()) * std_size_t_byteblob_size +
                        input_kv.values.size() * (g2_byteblob_size + g1_byteblob_size);
             }
 
             static inline void g2g1_knowledge_commitment_vector_process(
-                knowledge_commitment_vector<typename CurveType::template g2_type<>, typename CurveType::template g1_type<>>
-                    input_kv,
+                const knowledge_commitment_vector<typename CurveType::template g2_type<>,
+                                                  typename CurveType::template g1_type<>> &input_kv,
                 std::vector<chunk_type>::iterator &write_iter) {
 
                 std_size_t_process(get_g2g1_knowledge_commitment_vector_size(input_kv), write_iter);
@@ -1084,68 +1706,188 @@ namespace nil {
                 std_size_t_process(input_kv.domain_size(), write_iter);
             }
 
-            static inline std::vector<chunk_type> process(typename scheme_type::proving_key_type pk) {
+            /*
+             * Query vectors are serialized through a bounded staging buffer holding this many points, so
+             * writing a key to a stream needs no memory proportional to the key size.
+             */
+            constexpr static const std::size_t points_per_chunk = 1 << 14;
 
-                std::size_t proving_key_size = 3*g1_byteblob_size + 
-                    2*g2_byteblob_size + pk.A_query.size()*g1_byteblob_size +
-                    get_g2g1_knowledge_commitment_vector_size(pk.B_query) + 
-                    pk.H_query.size()*g1_byteblob_size + 
-                    pk.L_query.size()*g1_byteblob_size +
-                    2 * std_size_t_byteblob_size;
+            template<typename GroupType, typename InputIterator>
+            static inline void g1_group_type_batch_process(InputIterator first,
+                                                           std::size_t count,
+                                                           std::vector<chunk_type>::iterator write_iter) {
 
-                for (auto it = pk.constraint_system.constraints.begin(); 
-                        it != pk.constraint_system.constraints.end(); it++) {
-                    proving_key_size += get_r1cs_constraint_byteblob_size(*it);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    typename std::vector<chunk_type>::iterator point_write_iter = write_iter + i * g1_byteblob_size;
+                    g1_group_type_process<GroupType>(first[i], point_write_iter);
                 }
+            }
+
+            template<typename InputIterator>
+            static inline void g2g1_element_kc_batch_process(InputIterator first,
+                                                             std::size_t count,
+                                                             std::vector<chunk_type>::iterator write_iter) {
 
-                proving_key_size *= 2;
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                for (std::size_t i = 0; i < count; ++i) {
+                    typename std::vector<chunk_type>::iterator point_write_iter =
+                        write_iter + i * g2g1_element_kc_byteblob_size;
+                    g2g1_element_kc_process(first[i], point_write_iter);
+                }
+            }
 
-                std::vector<chunk_type> output(proving_key_size);
+            template<typename OutputIterator>
+            static inline OutputIterator std_size_t_process(std::size_t input_s,
+                                                            std::vector<chunk_type> &staging,
+                                                            OutputIterator out) {
 
-                typename std::vector<chunk_type>::iterator write_iter = output.begin();
+                typename std::vector<chunk_type>::iterator write_iter = staging.begin();
+                std_size_t_process(input_s, write_iter);
 
-                g1_group_type_process<typename CurveType::template g1_type<>>(pk.alpha_g1, write_iter);
-                g1_group_type_process<typename CurveType::template g1_type<>>(pk.beta_g1, write_iter);
-                g2_group_type_process<typename CurveType::template g2_type<>>(pk.beta_g2, write_iter);
-                g1_group_type_process<typename CurveType::template g1_type<>>(pk.delta_g1, write_iter);
-                g2_group_type_process<typename CurveType::template g2_type<>>(pk.delta_g2, write_iter);
+                return std::copy(staging.begin(), write_iter, out);
+            }
+
+            template<typename OutputIterator>
+            static inline OutputIterator
+                g1_vector_process(const std::vector<typename CurveType::template g1_type<>::value_type> &input_v,
+                                  std::vector<chunk_type> &staging,
+                                  OutputIterator out) {
 
-                std_size_t_process(pk.A_query.size(), write_iter);
+                out = std_size_t_process(input_v.size(), staging, out);
 
-                for (auto it = pk.A_query.begin(); it != pk.A_query.end(); it++) {
-                    g1_group_type_process<typename CurveType::template g1_type<>>(*it, write_iter);
+                for (std::size_t offset = 0; offset < input_v.size(); offset += points_per_chunk) {
+                    std::size_t count = std::min(points_per_chunk, input_v.size() - offset);
+
+                    g1_group_type_batch_process<typename CurveType::template g1_type<>>(input_v.begin() + offset,
+                                                                                        count, staging.begin());
+                    out = std::copy(staging.begin(), staging.begin() + count * g1_byteblob_size, out);
                 }
 
-                g2g1_knowledge_commitment_vector_process(pk.B_query, write_iter);
+                return out;
+            }
+
+            template<typename OutputIterator>
+            static inline OutputIterator g2g1_knowledge_commitment_vector_process(
+                const knowledge_commitment_vector<typename CurveType::template g2_type<>,
+                                                  typename CurveType::template g1_type<>> &input_kv,
+                std::vector<chunk_type> &staging,
+                OutputIterator out) {
 
-                std_size_t_process(pk.H_query.size(), write_iter);
+                out = std_size_t_process(get_g2g1_knowledge_commitment_vector_size(input_kv), staging, out);
+                out = std_size_t_process(input_kv.values.size(), staging, out);
 
-                for (auto it = pk.H_query.begin(); it != pk.H_query.end(); it++) {
-                    g1_group_type_process<typename CurveType::template g1_type<>>(*it, write_iter);
+                for (auto ic_iter = input_kv.indices.begin(); ic_iter != input_kv.indices.end(); ic_iter++) {
+                    out = std_size_t_process(*ic_iter, staging, out);
                 }
 
-                std_size_t_process(pk.L_query.size(), write_iter);
+                for (std::size_t offset = 0; offset < input_kv.values.size(); offset += points_per_chunk) {
+                    std::size_t count = std::min(points_per_chunk, input_kv.values.size() - offset);
 
-                for (auto it = pk.L_query.begin(); it != pk.L_query.end(); it++) {
-                    g1_group_type_process<typename CurveType::template g1_type<>>(*it, write_iter);
+                    g2g1_element_kc_batch_process(input_kv.values.begin() + offset, count, staging.begin());
+                    out = std::copy(staging.begin(), staging.begin() + count * g2g1_element_kc_byteblob_size, out);
                 }
 
-                r1cs_constraint_system_process<typename CurveType::scalar_field_type>(pk.constraint_system, write_iter);
-
-                return output;
+                return std_size_t_process(input_kv.domain_size(), staging, out);
             }
 
-            static inline std::vector<chunk_type> process(typename scheme_type::verification_key_type vk) {
+            template<typename OutputIterator>
+            static inline OutputIterator
+                r1cs_constraint_system_process(const r1cs_constraint_system<typename CurveType::scalar_field_type> &input_rs,
+                                               std::vector<chunk_type> &staging,
+                                               OutputIterator out) {
 
-                constexpr const std::size_t modulus_bits = CurveType::base_field_type::modulus_bits;
+                out = std_size_t_process(input_rs.primary_input_size, staging, out);
+                out = std_size_t_process(input_rs.auxiliary_input_size, staging, out);
+                out = std_size_t_process(input_rs.constraints.size(), staging, out);
 
-                constexpr const std::size_t modulus_chunks =
-                    modulus_bits / chunk_size + (modulus_bits % chunk_size ? 1 : 0);
+                for (auto it = input_rs.constraints.begin(); it != input_rs.constraints.end(); it++) {
+                    std::size_t constraint_byteblob_size = std_size_t_byteblob_size + get_r1cs_constraint_byteblob_size(*it);
 
-                std::size_t ic_size = 1 + vk.gamma_ABC_g1.rest.values.size();
+                    if (staging.size() < constraint_byteblob_size) {
+                        staging.resize(constraint_byteblob_size);
+                    }
 
-                std::size_t g1_byteblob_size = curve_element_serializer<CurveType>::sizeof_field_element;
-                std::size_t g2_byteblob_size = 2 * curve_element_serializer<CurveType>::sizeof_field_element;
+                    typename std::vector<chunk_type>::iterator write_iter = staging.begin();
+                    r1cs_constraint_process<typename CurveType::scalar_field_type>(*it, write_iter);
+                    out = std::copy(staging.begin(), write_iter, out);
+                }
+
+                return out;
+            }
+
+            /*
+             * Exact size of the proving key byteblob produced by process().
+             */
+            static inline std::size_t proving_key_byteblob_size(const typename scheme_type::proving_key_type &pk) {
+
+                std::size_t proving_key_size = 3 * g1_byteblob_size + 2 * g2_byteblob_size +
+                                               std_size_t_byteblob_size + pk.A_query.size() * g1_byteblob_size +
+                                               std_size_t_byteblob_size +
+                                               get_g2g1_knowledge_commitment_vector_size(pk.B_query) +
+                                               std_size_t_byteblob_size + pk.H_query.size() * g1_byteblob_size +
+                                               std_size_t_byteblob_size + pk.L_query.size() * g1_byteblob_size +
+                                               3 * std_size_t_byteblob_size;
+
+                for (auto it = pk.constraint_system->constraints.begin();
+                     it != pk.constraint_system->constraints.end();
+                     it++) {
+                    proving_key_size += std_size_t_byteblob_size + get_r1cs_constraint_byteblob_size(*it);
+                }
+
+                return proving_key_size;
+            }
+
+            /*
+             * Writes the proving key to an output iterator (e.g. std::ostreambuf_iterator) without copying
+             * the key. Points are compressed in parallel, a bounded batch at a time.
+             */
+            template<typename OutputIterator>
+            static inline OutputIterator process(const typename scheme_type::proving_key_type &pk, OutputIterator out) {
+
+                std::vector<chunk_type> staging(points_per_chunk * g2g1_element_kc_byteblob_size);
+                typename std::vector<chunk_type>::iterator write_iter = staging.begin();
+
+                g1_group_type_process<typename CurveType::template g1_type<>>(pk.alpha_g1, write_iter);
+                g1_group_type_process<typename CurveType::template g1_type<>>(pk.beta_g1, write_iter);
+                g2_group_type_process<typename CurveType::template g2_type<>>(pk.beta_g2, write_iter);
+                g1_group_type_process<typename CurveType::template g1_type<>>(pk.delta_g1, write_iter);
+                g2_group_type_process<typename CurveType::template g2_type<>>(pk.delta_g2, write_iter);
+
+                out = std::copy(staging.begin(), write_iter, out);
+
+                out = g1_vector_process(pk.A_query, staging, out);
+                out = g2g1_knowledge_commitment_vector_process(pk.B_query, staging, out);
+                out = g1_vector_process(pk.H_query, staging, out);
+                out = g1_vector_process(pk.L_query, staging, out);
+
+                return r1cs_constraint_system_process(*pk.constraint_system, staging, out);
+            }
+
+            static inline std::vector<chunk_type> process(const typename scheme_type::proving_key_type &pk) {
+
+                std::vector<chunk_type> output(proving_key_byteblob_size(pk));
+
+                process(pk, output.begin());
+
+                return output;
+            }
+
+            static inline std::vector<chunk_type> process(const typename scheme_type::verification_key_type &vk) {
+
+                constexpr const std::size_t modulus_bits = CurveType::base_field_type::modulus_bits;
+
+                constexpr const std::size_t modulus_chunks =
+                    modulus_bits / chunk_size + (modulus_bits % chunk_size ? 1 : 0);
+
+                std::size_t ic_size = 1 + vk.gamma_ABC_g1.rest.values.size();
+
+                std::size_t g1_byteblob_size = curve_element_serializer<CurveType>::sizeof_field_element;
+                std::size_t g2_byteblob_size = 2 * curve_element_serializer<CurveType>::sizeof_field_element;
                 std::size_t std_size_t_byteblob_size = 4;
 
                 std::size_t gt_byteblob_size = modulus_chunks * CurveType::gt_type::arity;
@@ -1180,7 +1922,7 @@ namespace nil {
                 return output;
             }
 
-            static inline std::vector<chunk_type> process(typename scheme_type::primary_input_type pi) {
+            static inline std::vector<chunk_type> process(const typename scheme_type::primary_input_type &pi) {
 
                 constexpr const std::size_t modulus_bits = CurveType::scalar_field_type::modulus_bits;
 
@@ -1206,7 +1948,7 @@ namespace nil {
                 return output;
             }
 
-            static inline std::vector<chunk_type> process(typename scheme_type::proof_type pr) {
+            static inline std::vector<chunk_type> process(const typename scheme_type::proof_type &pr) {
 
                 std::size_t g1_byteblob_size = curve_element_serializer<CurveType>::sizeof_field_element;
                 std::size_t g2_byteblob_size = 2 * curve_element_serializer<CurveType>::sizeof_field_element;
@@ -1225,6 +1967,605 @@ namespace nil {
             }
         };
 
+        /************************ Indexed key container *************************/
+
+        /*
+         * Sections of the indexed key container. Each section holds the same bytes the flat TVM
+         * serialization uses for the corresponding part of the key.
+         */
+        enum class key_container_section : std::uint8_t {
+            verification_key = 0,
+            proving_key_elements = 1,    // alpha_g1, beta_g1, beta_g2, delta_g1, delta_g2
+            A_query = 2,
+            B_query = 3,
+            H_query = 4,
+            L_query = 5,
+            constraint_system = 6
+        };
+
+        struct key_container_section_entry {
+            key_container_section section;
+            std::uint64_t offset;
+            std::uint64_t size;
+            std::uint32_t checksum;
+        };
+
+        /*
+         * Container layout:
+         *     magic | sections count | sections count * (section id | offset | size | crc32) | sections
+         * Offsets are counted from the beginning of the container. Offsets and sizes take 8 bytes, so
+         * the container is not limited to 4 GB like the length prefixes inside the sections.
+         */
+        struct key_container_tvm_format {
+            using chunk_type = std::uint8_t;
+
+            static const std::size_t magic_byteblob_size = 4;
+            static const std::size_t std_size_t_byteblob_size = 4;
+            static const std::size_t uint64_byteblob_size = 8;
+            static const std::size_t checksum_byteblob_size = 4;
+            static const std::size_t section_entry_byteblob_size =
+                std_size_t_byteblob_size + 2 * uint64_byteblob_size + checksum_byteblob_size;
+
+            static inline const std::array<chunk_type, magic_byteblob_size> &magic() {
+                static const std::array<chunk_type, magic_byteblob_size> value = {'Z', 'K', 'K', 'C'};
+                return value;
+            }
+
+            static inline std::size_t header_byteblob_size(std::size_t sections_count) {
+                return magic_byteblob_size + std_size_t_byteblob_size + sections_count * section_entry_byteblob_size;
+            }
+
+            static inline std::uint32_t checksum(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                 typename std::vector<chunk_type>::const_iterator read_iter_end) {
+                boost::crc_32_type result;
+
+                if (read_iter_begin != read_iter_end) {
+                    result.process_block(&*read_iter_begin, &*read_iter_begin + std::distance(read_iter_begin, read_iter_end));
+                }
+
+                return result.checksum();
+            }
+
+            static inline void uint_process(std::uint64_t input,
+                                            std::size_t byteblob_size,
+                                            std::vector<chunk_type>::iterator &write_iter) {
+                for (std::size_t i = 0; i < byteblob_size; ++i) {
+                    *write_iter++ = static_cast<chunk_type>(input >> (8 * (byteblob_size - 1 - i)));
+                }
+            }
+
+            static inline std::uint64_t uint_process(typename std::vector<chunk_type>::const_iterator &read_iter,
+                                                     std::size_t byteblob_size) {
+                std::uint64_t result = 0;
+
+                for (std::size_t i = 0; i < byteblob_size; ++i) {
+                    result = (result << 8) | *read_iter++;
+                }
+
+                return result;
+            }
+        };
+
+        template<typename ProofSystem>
+        struct key_container_serializer_tvm;
+
+        template<>
+        struct key_container_serializer_tvm<nil::crypto3::zk::snark::r1cs_gg_ppzksnark<algebra::curves::bls12<381>>>
+            : public key_container_tvm_format {
+
+            using CurveType = typename algebra::curves::bls12<381>;
+            using scheme_type = nil::crypto3::zk::snark::r1cs_gg_ppzksnark<CurveType>;
+            using serializer_type = verifier_input_serializer_tvm<scheme_type>;
+
+            using g1_type = typename CurveType::template g1_type<>;
+            using g2_type = typename CurveType::template g2_type<>;
+
+            using constraint_system_type = typename scheme_type::proving_key_type::constraint_system_type;
+
+            static inline std::vector<chunk_type> process(const typename scheme_type::proving_key_type &pk,
+                                                          const typename scheme_type::verification_key_type &vk) {
+                return container_process(&pk, &vk, pk.constraint_system.get());
+            }
+
+            static inline std::vector<chunk_type> process(const typename scheme_type::proving_key_type &pk) {
+                return container_process(&pk, nullptr, pk.constraint_system.get());
+            }
+
+            /**
+             * Keys generated for the same circuit share one constraint system, so it can be stored once with
+             * process(constraint_system) and omitted from each key container.
+             */
+            static inline std::vector<chunk_type>
+                detached_process(const typename scheme_type::proving_key_type &pk,
+                                 const typename scheme_type::verification_key_type &vk) {
+                return container_process(&pk, &vk, nullptr);
+            }
+
+            static inline std::vector<chunk_type> process(const constraint_system_type &constraint_system) {
+                return container_process(nullptr, nullptr, &constraint_system);
+            }
+
+        private:
+            static inline std::size_t g1_vector_byteblob_size(const std::vector<typename g1_type::value_type> &input_v) {
+                return serializer_type::std_size_t_byteblob_size + input_v.size() * serializer_type::g1_byteblob_size;
+            }
+
+            static inline void g1_vector_process(const std::vector<typename g1_type::value_type> &input_v,
+                                                 std::vector<chunk_type>::iterator &write_iter) {
+                serializer_type::std_size_t_process(input_v.size(), write_iter);
+                serializer_type::g1_group_type_batch_process<g1_type>(input_v.begin(), input_v.size(), write_iter);
+                write_iter += input_v.size() * serializer_type::g1_byteblob_size;
+            }
+
+            static inline std::vector<chunk_type>
+                container_process(const typename scheme_type::proving_key_type *pk,
+                                  const typename scheme_type::verification_key_type *vk,
+                                  const constraint_system_type *constraint_system) {
+
+                std::vector<chunk_type> vk_byteblob;
+                if (vk) {
+                    vk_byteblob = serializer_type::process(*vk);
+                }
+
+                std::vector<key_container_section_entry> entries;
+                if (vk) {
+                    entries.push_back({key_container_section::verification_key, 0, vk_byteblob.size(), 0});
+                }
+                if (pk) {
+                    entries.push_back({key_container_section::proving_key_elements, 0,
+                                       3 * serializer_type::g1_byteblob_size + 2 * serializer_type::g2_byteblob_size,
+                                       0});
+                    entries.push_back({key_container_section::A_query, 0, g1_vector_byteblob_size(pk->A_query), 0});
+                    entries.push_back({key_container_section::B_query, 0,
+                                       serializer_type::std_size_t_byteblob_size +
+                                           serializer_type::get_g2g1_knowledge_commitment_vector_size(pk->B_query),
+                                       0});
+                    entries.push_back({key_container_section::H_query, 0, g1_vector_byteblob_size(pk->H_query), 0});
+                    entries.push_back({key_container_section::L_query, 0, g1_vector_byteblob_size(pk->L_query), 0});
+                }
+                if (constraint_system) {
+                    std::size_t cs_byteblob_size = 3 * serializer_type::std_size_t_byteblob_size;
+                    for (auto it = constraint_system->constraints.begin(); it != constraint_system->constraints.end();
+                         it++) {
+                        cs_byteblob_size += serializer_type::std_size_t_byteblob_size +
+                                            serializer_type::get_r1cs_constraint_byteblob_size(*it);
+                    }
+
+                    entries.push_back({key_container_section::constraint_system, 0, cs_byteblob_size, 0});
+                }
+
+                std::uint64_t offset = header_byteblob_size(entries.size());
+                for (auto &entry : entries) {
+                    entry.offset = offset;
+                    offset += entry.size;
+                }
+
+                std::vector<chunk_type> output(offset);
+
+                for (auto &entry : entries) {
+                    std::vector<chunk_type>::iterator write_iter = output.begin() + entry.offset;
+
+                    switch (entry.section) {
+                        case key_container_section::verification_key:
+                            write_iter = std::copy(vk_byteblob.begin(), vk_byteblob.end(), write_iter);
+                            break;
+                        case key_container_section::proving_key_elements:
+                            serializer_type::g1_group_type_process<g1_type>(pk->alpha_g1, write_iter);
+                            serializer_type::g1_group_type_process<g1_type>(pk->beta_g1, write_iter);
+                            serializer_type::g2_group_type_process<g2_type>(pk->beta_g2, write_iter);
+                            serializer_type::g1_group_type_process<g1_type>(pk->delta_g1, write_iter);
+                            serializer_type::g2_group_type_process<g2_type>(pk->delta_g2, write_iter);
+                            break;
+                        case key_container_section::A_query:
+                            g1_vector_process(pk->A_query, write_iter);
+                            break;
+                        case key_container_section::B_query:
+                            serializer_type::g2g1_knowledge_commitment_vector_process(pk->B_query, write_iter);
+                            break;
+                        case key_container_section::H_query:
+                            g1_vector_process(pk->H_query, write_iter);
+                            break;
+                        case key_container_section::L_query:
+                            g1_vector_process(pk->L_query, write_iter);
+                            break;
+                        case key_container_section::constraint_system:
+                            serializer_type::r1cs_constraint_system_process<typename CurveType::scalar_field_type>(
+                                *constraint_system, write_iter);
+                            break;
+                    }
+
+                    BOOST_ASSERT(write_iter == output.begin() + entry.offset + entry.size);
+
+                    entry.checksum = checksum(output.cbegin() + entry.offset, output.cbegin() + entry.offset + entry.size);
+                }
+
+                std::vector<chunk_type>::iterator write_iter = output.begin();
+
+                write_iter = std::copy(magic().begin(), magic().end(), write_iter);
+                serializer_type::std_size_t_process(entries.size(), write_iter);
+
+                for (const auto &entry : entries) {
+                    serializer_type::std_size_t_process(static_cast<std::size_t>(entry.section), write_iter);
+                    uint_process(entry.offset, uint64_byteblob_size, write_iter);
+                    uint_process(entry.size, uint64_byteblob_size, write_iter);
+                    uint_process(entry.checksum, checksum_byteblob_size, write_iter);
+                }
+
+                return output;
+            }
+        };
+
+        template<typename ProofSystem>
+        struct key_container_deserializer_tvm;
+
+        /*
+         * Every section can be loaded on its own: a caller holding only the header (its size is given by
+         * header_byteblob_size()) can read just the byte range of the sections it needs, e.g. a verifier
+         * reads the verification key section and never touches the query vectors.
+         */
+        template<>
+        struct key_container_deserializer_tvm<nil::crypto3::zk::snark::r1cs_gg_ppzksnark<algebra::curves::bls12<381>>>
+            : public key_container_tvm_format {
+
+            using CurveType = typename algebra::curves::bls12<381>;
+            using scheme_type = nil::crypto3::zk::snark::r1cs_gg_ppzksnark<CurveType>;
+            using deserializer_type = verifier_input_deserializer_tvm<scheme_type>;
+            using constraint_system_type = typename scheme_type::proving_key_type::constraint_system_type;
+
+            using g1_type = typename CurveType::template g1_type<>;
+            using g2_type = typename CurveType::template g2_type<>;
+
+            /*
+             * Parses the container header. read_iter_end may point anywhere past the header.
+             */
+            static inline std::vector<key_container_section_entry>
+                header_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                               typename std::vector<chunk_type>::const_iterator read_iter_end,
+                               status_type &processingStatus) {
+
+                processingStatus = status_type::success;
+
+                if (std::distance(read_iter_begin, read_iter_end) < header_byteblob_size(0)) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return std::vector<key_container_section_entry>();
+                }
+
+                if (!std::equal(magic().begin(), magic().end(), read_iter_begin)) {
+
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return std::vector<key_container_section_entry>();
+                }
+
+                typename std::vector<chunk_type>::const_iterator read_iter = read_iter_begin + magic_byteblob_size;
+                std::size_t sections_count = uint_process(read_iter, std_size_t_byteblob_size);
+
+                if (sections_count > (std::size_t(std::distance(read_iter_begin, read_iter_end)) - header_byteblob_size(0)) /
+                                         section_entry_byteblob_size) {
+
+                    processingStatus = status_type::not_enough_data;
+
+                    return std::vector<key_container_section_entry>();
+                }
+
+                std::vector<key_container_section_entry> entries(sections_count);
+
+                for (auto &entry : entries) {
+                    entry.section = static_cast<key_container_section>(uint_process(read_iter, std_size_t_byteblob_size));
+                    entry.offset = uint_process(read_iter, uint64_byteblob_size);
+                    entry.size = uint_process(read_iter, uint64_byteblob_size);
+                    entry.checksum = static_cast<std::uint32_t>(uint_process(read_iter, checksum_byteblob_size));
+                }
+
+                return entries;
+            }
+
+            static inline typename std::vector<key_container_section_entry>::const_iterator
+                find_section(const std::vector<key_container_section_entry> &entries, key_container_section section) {
+                return std::find_if(entries.begin(), entries.end(),
+                                    [section](const key_container_section_entry &entry) {
+                                        return entry.section == section;
+                                    });
+            }
+
+            /*
+             * Checks that [read_iter_begin, read_iter_end) holds the bytes of the section described by
+             * entry. Every *_section_process function below does this before parsing.
+             */
+            static inline bool section_check(const key_container_section_entry &entry,
+                                             typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                             typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                             status_type &processingStatus) {
+
+                processingStatus = status_type::success;
+
+                if (std::distance(read_iter_begin, read_iter_end) != entry.size) {
+                    processingStatus = status_type::not_enough_data;
+
+                    return false;
+                }
+
+                if (checksum(read_iter_begin, read_iter_end) != entry.checksum) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return false;
+                }
+
+                return true;
+            }
+
+            static inline typename scheme_type::verification_key_type
+                verification_key_section_process(const key_container_section_entry &entry,
+                                                 typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                 typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                                 status_type &processingStatus) {
+
+                if (!section_check(entry, read_iter_begin, read_iter_end, processingStatus)) {
+                    return typename scheme_type::verification_key_type();
+                }
+
+                return deserializer_type::verification_key_process(read_iter_begin, read_iter_end, processingStatus);
+            }
+
+            static inline std::vector<typename g1_type::value_type>
+                g1_query_section_process(const key_container_section_entry &entry,
+                                         typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                         typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                         status_type &processingStatus) {
+
+                if (!section_check(entry, read_iter_begin, read_iter_end, processingStatus)) {
+                    return std::vector<typename g1_type::value_type>();
+                }
+
+                std::size_t query_size = deserializer_type::std_size_t_process(
+                    read_iter_begin, read_iter_begin + deserializer_type::std_size_t_byteblob_size, processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return std::vector<typename g1_type::value_type>();
+                }
+
+                return deserializer_type::g1_group_type_batch_process<g1_type>(
+                    read_iter_begin + deserializer_type::std_size_t_byteblob_size, read_iter_end, query_size,
+                    processingStatus);
+            }
+
+            static inline knowledge_commitment_vector<g2_type, g1_type>
+                B_query_section_process(const key_container_section_entry &entry,
+                                        typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                        typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                        status_type &processingStatus) {
+
+                if (!section_check(entry, read_iter_begin, read_iter_end, processingStatus)) {
+                    return knowledge_commitment_vector<g2_type, g1_type>();
+                }
+
+                return deserializer_type::g2g1_knowledge_commitment_vector_process(
+                    read_iter_begin + deserializer_type::std_size_t_byteblob_size, read_iter_end, processingStatus);
+            }
+
+            static inline r1cs_constraint_system<typename CurveType::scalar_field_type>
+                constraint_system_section_process(const key_container_section_entry &entry,
+                                                  typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                  typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                                  status_type &processingStatus) {
+
+                if (!section_check(entry, read_iter_begin, read_iter_end, processingStatus)) {
+                    return r1cs_constraint_system<typename CurveType::scalar_field_type>();
+                }
+
+                return deserializer_type::r1cs_constraint_system_process(read_iter_begin, read_iter_end,
+                                                                         processingStatus);
+            }
+
+            /*
+             * Loads the verification key from a whole container without decoding any proving key section.
+             */
+            static inline typename scheme_type::verification_key_type
+                verification_key_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                         typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                         status_type &processingStatus) {
+
+                std::vector<key_container_section_entry> entries =
+                    header_process(read_iter_begin, read_iter_end, processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::verification_key_type();
+                }
+
+                auto entry = find_section(entries, key_container_section::verification_key);
+
+                if (entry == entries.end() || !section_in_range(*entry, read_iter_begin, read_iter_end)) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return typename scheme_type::verification_key_type();
+                }
+
+                return verification_key_section_process(*entry, read_iter_begin + entry->offset,
+                                                        read_iter_begin + entry->offset + entry->size,
+                                                        processingStatus);
+            }
+
+            static inline std::shared_ptr<const constraint_system_type>
+                constraint_system_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                          typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                          status_type &processingStatus) {
+
+                std::vector<key_container_section_entry> entries =
+                    header_process(read_iter_begin, read_iter_end, processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return nullptr;
+                }
+
+                auto entry = find_section(entries, key_container_section::constraint_system);
+
+                if (entry == entries.end() || !section_in_range(*entry, read_iter_begin, read_iter_end)) {
+                    processingStatus = status_type::invalid_msg_data;
+
+                    return nullptr;
+                }
+
+                constraint_system_type constraint_system = constraint_system_section_process(
+                    *entry, read_iter_begin + entry->offset, read_iter_begin + entry->offset + entry->size,
+                    processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return nullptr;
+                }
+
+                return std::make_shared<const constraint_system_type>(std::move(constraint_system));
+            }
+
+            static inline typename scheme_type::proving_key_type
+                proving_key_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                    typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                    status_type &processingStatus) {
+                return proving_key_process(read_iter_begin, read_iter_end, nullptr, processingStatus);
+            }
+
+            /**
+             * Attaches the given constraint system to the key instead of reading one from the container, so
+             * keys for the same circuit loaded from detached containers share it.
+             */
+            static inline typename scheme_type::proving_key_type
+                proving_key_process(typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                    typename std::vector<chunk_type>::const_iterator read_iter_end,
+                                    const std::shared_ptr<const constraint_system_type> &constraint_system,
+                                    status_type &processingStatus) {
+
+                std::vector<key_container_section_entry> entries =
+                    header_process(read_iter_begin, read_iter_end, processingStatus);
+
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                std::vector<key_container_section> proving_key_sections = {
+                    key_container_section::proving_key_elements, key_container_section::A_query,
+                    key_container_section::B_query, key_container_section::H_query, key_container_section::L_query};
+                if (!constraint_system) {
+                    proving_key_sections.push_back(key_container_section::constraint_system);
+                }
+
+                for (key_container_section section : proving_key_sections) {
+                    auto entry = find_section(entries, section);
+
+                    if (entry == entries.end() || !section_in_range(*entry, read_iter_begin, read_iter_end)) {
+                        processingStatus = status_type::invalid_msg_data;
+
+                        return typename scheme_type::proving_key_type();
+                    }
+                }
+
+                auto section_begin = [&](key_container_section section) {
+                    return read_iter_begin + find_section(entries, section)->offset;
+                };
+                auto section_end = [&](key_container_section section) {
+                    auto entry = find_section(entries, section);
+                    return read_iter_begin + entry->offset + entry->size;
+                };
+
+                typename scheme_type::proving_key_type pk;
+
+                const key_container_section_entry &elements =
+                    *find_section(entries, key_container_section::proving_key_elements);
+
+                if (!section_check(elements, section_begin(elements.section), section_end(elements.section),
+                                   processingStatus)) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                typename std::vector<chunk_type>::const_iterator read_iter = section_begin(elements.section);
+
+                pk.alpha_g1 = deserializer_type::g1_group_type_process<g1_type>(
+                    read_iter, read_iter + deserializer_type::g1_byteblob_size, processingStatus);
+                read_iter += deserializer_type::g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+                pk.beta_g1 = deserializer_type::g1_group_type_process<g1_type>(
+                    read_iter, read_iter + deserializer_type::g1_byteblob_size, processingStatus);
+                read_iter += deserializer_type::g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+                pk.beta_g2 = deserializer_type::g2_group_type_process<g2_type>(
+                    read_iter, read_iter + deserializer_type::g2_byteblob_size, processingStatus);
+                read_iter += deserializer_type::g2_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+                pk.delta_g1 = deserializer_type::g1_group_type_process<g1_type>(
+                    read_iter, read_iter + deserializer_type::g1_byteblob_size, processingStatus);
+                read_iter += deserializer_type::g1_byteblob_size;
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+                pk.delta_g2 = deserializer_type::g2_group_type_process<g2_type>(
+                    read_iter, read_iter + deserializer_type::g2_byteblob_size, processingStatus);
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                pk.A_query = g1_query_section_process(*find_section(entries, key_container_section::A_query),
+                                                      section_begin(key_container_section::A_query),
+                                                      section_end(key_container_section::A_query), processingStatus);
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                pk.B_query = B_query_section_process(*find_section(entries, key_container_section::B_query),
+                                                     section_begin(key_container_section::B_query),
+                                                     section_end(key_container_section::B_query), processingStatus);
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                pk.H_query = g1_query_section_process(*find_section(entries, key_container_section::H_query),
+                                                      section_begin(key_container_section::H_query),
+                                                      section_end(key_container_section::H_query), processingStatus);
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                pk.L_query = g1_query_section_process(*find_section(entries, key_container_section::L_query),
+                                                      section_begin(key_container_section::L_query),
+                                                      section_end(key_container_section::L_query), processingStatus);
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                if (constraint_system) {
+                    pk.constraint_system = constraint_system;
+
+                    return pk;
+                }
+
+                constraint_system_type loaded_constraint_system = constraint_system_section_process(
+                    *find_section(entries, key_container_section::constraint_system),
+                    section_begin(key_container_section::constraint_system),
+                    section_end(key_container_section::constraint_system), processingStatus);
+                if (processingStatus != status_type::success) {
+                    return typename scheme_type::proving_key_type();
+                }
+
+                pk.constraint_system = std::make_shared<const constraint_system_type>(std::move(loaded_constraint_system));
+
+                return pk;
+            }
+
+        private:
+            static inline bool section_in_range(const key_container_section_entry &entry,
+                                                typename std::vector<chunk_type>::const_iterator read_iter_begin,
+                                                typename std::vector<chunk_type>::const_iterator read_iter_end) {
+                std::uint64_t container_size = std::distance(read_iter_begin, read_iter_end);
+
+                return entry.offset <= container_size && entry.size <= container_size - entry.offset;
+            }
+        };
+
     }    // namespace marshalling
 }    // namespace nil
 
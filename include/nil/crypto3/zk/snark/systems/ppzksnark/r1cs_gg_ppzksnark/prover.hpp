@@ -69,17 +69,56 @@ namespace nil {
                     typedef typename policy_type::proving_key_type proving_key_type;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * Buffers reused across proofs for one proving key, see r1cs_to_qap::workspace_type.
+                     */
+                    struct workspace_type {
+                        explicit workspace_type(const proving_key_type &proving_key) :
+                            qap(*proving_key.constraint_system) {
+                            const_padded_assignment.reserve(proving_key.constraint_system->num_variables() + 1);
+                        }
+
+                        typename reductions::r1cs_to_qap<scalar_field_type>::workspace_type qap;
+                        std::vector<typename scalar_field_type::value_type> const_padded_assignment;
+                    };
+
                     static inline proof_type process(const proving_key_type &proving_key,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        workspace_type workspace(proving_key);
 
-                        BOOST_ASSERT(proving_key.constraint_system.is_satisfied(primary_input, auxiliary_input));
+                        return process(proving_key, primary_input, auxiliary_input, workspace);
+                    }
 
-                        const qap_witness<scalar_field_type> qap_wit =
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     workspace_type &workspace) {
+                        /* Choose two random field elements for prover zero-knowledge. */
+                        const typename scalar_field_type::value_type r = algebra::random_element<scalar_field_type>();
+                        const typename scalar_field_type::value_type s = algebra::random_element<scalar_field_type>();
+
+                        return process(proving_key, primary_input, auxiliary_input, r, s, workspace);
+                    }
+
+                    /**
+                     * Prover with the zero-knowledge randomness r, s given by the caller, so that proofs can be
+                     * generated concurrently once it has been drawn.
+                     */
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     const typename scalar_field_type::value_type &r,
+                                                     const typename scalar_field_type::value_type &s,
+                                                     workspace_type &workspace) {
+
+                        BOOST_ASSERT(proving_key.constraint_system->is_satisfied(primary_input, auxiliary_input));
+
+                        const qap_witness<scalar_field_type> &qap_wit =
                             reductions::r1cs_to_qap<scalar_field_type>::witness_map(
-                                proving_key.constraint_system, primary_input, auxiliary_input,
+                                *proving_key.constraint_system, primary_input, auxiliary_input,
                                 scalar_field_type::value_type::zero(), scalar_field_type::value_type::zero(),
-                                scalar_field_type::value_type::zero());
+                                scalar_field_type::value_type::zero(), workspace.qap);
 
                         /* We are dividing degree 2(d-1) polynomial by degree d polynomial
                            and not adding a PGHR-style ZK-patch, so our H is degree d-2 */
@@ -87,9 +126,6 @@ namespace nil {
                         BOOST_ASSERT(qap_wit.coefficients_for_H[qap_wit.degree - 1].is_zero());
                         BOOST_ASSERT(qap_wit.coefficients_for_H[qap_wit.degree].is_zero());
 
-                        /* Choose two random field elements for prover zero-knowledge. */
-                        const typename scalar_field_type::value_type r = algebra::random_element<scalar_field_type>();
-                        const typename scalar_field_type::value_type s = algebra::random_element<scalar_field_type>();
 #ifdef MULTICORE
                         const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
                                                                              // var or call omp_set_num_threads()
@@ -98,8 +134,9 @@ namespace nil {
 #endif
 
                         // TODO: sort out indexing
-                        std::vector<typename scalar_field_type::value_type> const_padded_assignment(
-                            1, scalar_field_type::value_type::one());
+                        std::vector<typename scalar_field_type::value_type> &const_padded_assignment =
+                            workspace.const_padded_assignment;
+                        const_padded_assignment.assign(1, scalar_field_type::value_type::one());
                         const_padded_assignment.insert(const_padded_assignment.end(),
                                                        qap_wit.coefficients_for_ABCs.begin(),
                                                        qap_wit.coefficients_for_ABCs.end());
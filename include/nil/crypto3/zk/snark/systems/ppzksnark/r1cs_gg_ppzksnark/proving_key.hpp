@@ -26,6 +26,8 @@
 #ifndef CRYPTO3_R1CS_GG_PPZKSNARK_PROVING_KEY_HPP
 #define CRYPTO3_R1CS_GG_PPZKSNARK_PROVING_KEY_HPP
 
+#include <memory>
+
 #include <nil/crypto3/zk/snark/commitments/knowledge_commitment.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs.hpp>
 #include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark/modes.hpp>
@@ -54,7 +56,8 @@ namespace nil {
                     std::vector<typename CurveType::template g1_type<>::value_type> H_query;
                     std::vector<typename CurveType::template g1_type<>::value_type> L_query;
 
-                    constraint_system_type constraint_system;
+                    /* Immutable and shared between copies of the key and keys generated for the same circuit */
+                    std::shared_ptr<const constraint_system_type> constraint_system;
 
                     r1cs_gg_ppzksnark_proving_key() {};
                     r1cs_gg_ppzksnark_proving_key &operator=(const r1cs_gg_ppzksnark_proving_key &other) = default;
@@ -75,7 +78,8 @@ namespace nil {
                         const constraint_system_type &constraint_system) :
                         alpha_g1(alpha_g1),
                         beta_g1(beta_g1), beta_g2(beta_g2), delta_g1(delta_g1), delta_g2(delta_g2), A_query(A_query),
-                        B_query(B_query), H_query(H_query), L_query(L_query), constraint_system(constraint_system) {};
+                        B_query(B_query), H_query(H_query), L_query(L_query),
+                        constraint_system(std::make_shared<const constraint_system_type>(constraint_system)) {};
 
                     r1cs_gg_ppzksnark_proving_key(
                         typename CurveType::template g1_type<>::value_type &&alpha_g1,
@@ -93,6 +97,24 @@ namespace nil {
                         beta_g1(std::move(beta_g1)), beta_g2(std::move(beta_g2)), delta_g1(std::move(delta_g1)),
                         delta_g2(std::move(delta_g2)), A_query(std::move(A_query)), B_query(std::move(B_query)),
                         H_query(std::move(H_query)), L_query(std::move(L_query)),
+                        constraint_system(std::make_shared<const constraint_system_type>(std::move(constraint_system))) {};
+
+                    r1cs_gg_ppzksnark_proving_key(
+                        typename CurveType::template g1_type<>::value_type &&alpha_g1,
+                        typename CurveType::template g1_type<>::value_type &&beta_g1,
+                        typename CurveType::template g2_type<>::value_type &&beta_g2,
+                        typename CurveType::template g1_type<>::value_type &&delta_g1,
+                        typename CurveType::template g2_type<>::value_type &&delta_g2,
+                        std::vector<typename CurveType::template g1_type<>::value_type> &&A_query,
+                        knowledge_commitment_vector<typename CurveType::template g2_type<>,
+                                                    typename CurveType::template g1_type<>> &&B_query,
+                        std::vector<typename CurveType::template g1_type<>::value_type> &&H_query,
+                        std::vector<typename CurveType::template g1_type<>::value_type> &&L_query,
+                        std::shared_ptr<const constraint_system_type> constraint_system) :
+                        alpha_g1(std::move(alpha_g1)),
+                        beta_g1(std::move(beta_g1)), beta_g2(std::move(beta_g2)), delta_g1(std::move(delta_g1)),
+                        delta_g2(std::move(delta_g2)), A_query(std::move(A_query)), B_query(std::move(B_query)),
+                        H_query(std::move(H_query)), L_query(std::move(L_query)),
                         constraint_system(std::move(constraint_system)) {};
 
                     std::size_t G1_size() const {
@@ -125,7 +147,10 @@ namespace nil {
                                 this->beta_g2 == other.beta_g2 && this->delta_g1 == other.delta_g1 &&
                                 this->delta_g2 == other.delta_g2 && this->A_query == other.A_query &&
                                 this->B_query == other.B_query && this->H_query == other.H_query &&
-                                this->L_query == other.L_query && this->constraint_system == other.constraint_system);
+                                this->L_query == other.L_query &&
+                                (this->constraint_system == other.constraint_system ||
+                                 (this->constraint_system && other.constraint_system &&
+                                  *this->constraint_system == *other.constraint_system)));
                     }
                 };
             }    // namespace snark
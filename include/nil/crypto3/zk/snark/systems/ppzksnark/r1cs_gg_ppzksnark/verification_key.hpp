@@ -108,7 +108,11 @@ namespace nil {
                     typename pairing_policy::g2_precomputed_type vk_delta_g2_precomp;
 
                     accumulation_vector<typename CurveType::template g1_type<>> gamma_ABC_g1;
+                    /* window tables for gamma_ABC_g1, empty unless the key was processed for many verifications */
+                    fixed_base_accumulation_vector<typename CurveType::template g1_type<>> gamma_ABC_g1_precomp;
 
+                    /* gamma_ABC_g1_precomp is derived from gamma_ABC_g1 and left out on purpose: keys processed
+                       for different numbers of verifications verify the same proofs and compare equal */
                     bool operator==(const r1cs_gg_ppzksnark_processed_verification_key &other) const {
                         return (this->vk_alpha_g1_beta_g2 == other.vk_alpha_g1_beta_g2 &&
                                 this->vk_gamma_g2_precomp == other.vk_gamma_g2_precomp &&
@@ -50,6 +50,8 @@
 #ifndef CRYPTO3_ZK_R1CS_GG_PPZKSNARK_BASIC_VERIFIER_HPP
 #define CRYPTO3_ZK_R1CS_GG_PPZKSNARK_BASIC_VERIFIER_HPP
 
+#include <type_traits>
+
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
 
 #include <nil/crypto3/zk/snark/accumulation_vector.hpp>
@@ -98,6 +100,44 @@ namespace nil {
 
                         return processed_verification_key;
                     }
+
+                    /**
+                     * Upper bound on the memory process(verification_key, num_verifications) spends on window tables.
+                     */
+                    static constexpr std::size_t default_max_table_bytes = std::size_t(1) << 28;
+
+                    /**
+                     * Same as above, for a key used in num_verifications verifications: the processed key also
+                     * holds window tables for gamma_ABC_g1, so every input costs one windowed exponentiation.
+                     *
+                     * The window is the one get_exp_window_size() picks for num_verifications exponentiations
+                     * per base, lowered until the tables, fixed_base_accumulation_vector::table_size() points per
+                     * input, fit in max_table_bytes. If not even a 1-bit window fits, no tables are built.
+                     */
+                    static inline processed_verification_key_type
+                        process(const verification_key_type &verification_key, std::size_t num_verifications,
+                                std::size_t max_table_bytes = default_max_table_bytes) {
+                        typedef typename CurveType::template g1_type<> g1_type;
+
+                        const std::size_t scalar_size = CurveType::scalar_field_type::value_bits;
+                        const std::size_t num_bases = verification_key.gamma_ABC_g1.rest.indices.size();
+                        std::size_t window = algebra::get_exp_window_size<g1_type>(num_verifications);
+                        while (window > 0 &&
+                               num_bases * fixed_base_accumulation_vector<g1_type>::table_size(scalar_size, window) *
+                                       sizeof(typename g1_type::value_type) >
+                                   max_table_bytes) {
+                            --window;
+                        }
+
+                        processed_verification_key_type processed_verification_key = process(verification_key);
+                        if (window > 0) {
+                            processed_verification_key.gamma_ABC_g1_precomp =
+                                fixed_base_accumulation_vector<g1_type>(verification_key.gamma_ABC_g1, scalar_size,
+                                                                        window);
+                        }
+
+                        return processed_verification_key;
+                    }
                 };
 
                 /**
@@ -142,6 +182,25 @@ namespace nil {
                                        primary_input, proof);
                     }
 
+                    /**
+                     * The input term gamma_ABC_g1.first + sum_i primary_input[i] * gamma_ABC_g1.rest[i] of the
+                     * verification equation. It allocates nothing if the key was processed with window tables,
+                     * see r1cs_gg_ppzksnark_process_verification_key::process(verification_key,
+                     * num_verifications), and runs multiexps otherwise.
+                     */
+                    static inline typename g1_type::value_type
+                        accumulate_input(const processed_verification_key_type &processed_verification_key,
+                                         const primary_input_type &primary_input) {
+
+                        assert(processed_verification_key.gamma_ABC_g1.domain_size() >= primary_input.size());
+
+                        return processed_verification_key.gamma_ABC_g1_precomp.empty() ?
+                                   processed_verification_key.gamma_ABC_g1.accumulate(primary_input.begin(),
+                                                                                      primary_input.end()) :
+                                   processed_verification_key.gamma_ABC_g1_precomp.accumulate(primary_input.begin(),
+                                                                                              primary_input.end());
+                    }
+
                     /**
                      * A verifier algorithm for the R1CS GG-ppzkSNARK that:
                      * (1) accepts a processed verification key, and
@@ -151,13 +210,8 @@ namespace nil {
                                                const primary_input_type &primary_input,
                                                const proof_type &proof) {
 
-                        assert(processed_verification_key.gamma_ABC_g1.domain_size() >= primary_input.size());
-
-                        const accumulation_vector<g1_type> accumulated_IC =
-                            processed_verification_key.gamma_ABC_g1.accumulate_chunk(primary_input.begin(),
-                                                                                     primary_input.end(), 0);
-
-                        const typename g1_type::value_type &acc = accumulated_IC.first;
+                        const typename g1_type::value_type acc =
+                            accumulate_input(processed_verification_key, primary_input);
 
                         bool result = true;
 
@@ -230,75 +284,85 @@ namespace nil {
                     }
                 };
 
-                // /**
-                //  *
-                //  * A verifier algorithm for the R1CS GG-ppzkSNARK that:
-                //  * (1) accepts a non-processed verification key,
-                //  * (2) has weak input consistency, and
-                //  * (3) uses affine coordinates for elliptic-curve computations.
-                //  */
-                // template<typename CurveType>
-                // class r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency {
-                //     typedef detail::r1cs_gg_ppzksnark_basic_policy<CurveType, ProvingMode::Basic> policy_type;
-
-                //     typedef typename CurveType::scalar_field_type scalar_field_type;
-                //     typedef typename CurveType::template g1_type<> g1_type;
-                //     typedef typename CurveType::gt_type gt_type;
-                //     typedef typename pairing::pairing_policy<CurveType>::affine_ate_g1_precomp affine_ate_g1_precomp;
-                //     typedef typename pairing::pairing_policy<CurveType>::affine_ate_g2_precomp affine_ate_g2_precomp;
-
-                // public:
-                //     typedef typename policy_type::primary_input_type primary_input_type;
-
-                //     typedef typename policy_type::verification_key_type verification_key_type;
-                //     typedef typename policy_type::processed_verification_key_type processed_verification_key_type;
-
-                //     typedef typename policy_type::proof_type proof_type;
-
-                //     static inline bool process(const verification_key_type &verification_key,
-                //                                const primary_input_type &primary_input,
-                //                                const proof_type &proof) {
-
-                //         BOOST_ASSERT(verification_key.gamma_ABC_g1.domain_size() >= primary_input.size());
-
-                //         affine_ate_g2_precomp pvk_vk_gamma_g2_precomp =
-                //             affine_ate_precompute_g2<CurveType>(verification_key.gamma_g2);
-                //         affine_ate_g2_precomp pvk_vk_delta_g2_precomp =
-                //             affine_ate_precompute_g2<CurveType>(verification_key.delta_g2);
-
-                //         const accumulation_vector<g1_type> accumulated_IC =
-                //             verification_key.gamma_ABC_g1.accumulate_chunk(primary_input.begin(),
-                //             primary_input.end(),
-                //                                                            0);
-                //         const typename g1_type::value_type &acc = accumulated_IC.first;
-
-                //         bool result = true;
-
-                //         if (!proof.is_well_formed()) {
-                //             result = false;
-                //         }
-
-                //         const affine_ate_g1_precomp proof_g_A_precomp =
-                //             affine_ate_precompute_g1<CurveType>(proof.g_A);
-                //         const affine_ate_g2_precomp proof_g_B_precomp =
-                //             affine_ate_precompute_g2<CurveType>(proof.g_B);
-                //         const affine_ate_g1_precomp proof_g_C_precomp =
-                //             affine_ate_precompute_g1<CurveType>(proof.g_C);
-                //         const affine_ate_g1_precomp acc_precomp = affine_ate_precompute_g1<CurveType>(acc);
-
-                //         const typename fqk_type::value_type QAP_miller =
-                //             affine_ate_e_times_e_over_e_miller_loop<CurveType>(
-                //                 acc_precomp, pvk_vk_gamma_g2_precomp, proof_g_C_precomp, pvk_vk_delta_g2_precomp,
-                //                 proof_g_A_precomp, proof_g_B_precomp);
-                //         const typename gt_type::value_type QAP =
-                //             final_exponentiation<CurveType>(QAP_miller.unitary_inversed());
-
-                //         if (QAP != verification_key.alpha_g1_beta_g2) {
-                //             result = false;
-                //         }
-                //         return result;
-                //     }
-                // };
+                /**
+                 * Whether the pairing of CurveType provides the affine ate Miller loop used by
+                 * r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency (as it does for the MNT curves).
+                 */
+                template<typename CurveType, typename = void>
+                struct has_affine_pairing : std::false_type { };
+
+                template<typename CurveType>
+                struct has_affine_pairing<
+                    CurveType,
+                    std::void_t<typename pairing::pairing_policy<CurveType>::affine_ate_g1_precomp,
+                                typename pairing::pairing_policy<CurveType>::affine_ate_g2_precomp>> : std::true_type {
+                };
+
+                /**
+                 * A verifier algorithm for the R1CS GG-ppzkSNARK that:
+                 * (1) accepts a non-processed verification key,
+                 * (2) has weak input consistency, and
+                 * (3) uses affine coordinates for elliptic-curve computations.
+                 *
+                 * The whole check runs as a single e(acc, gamma) * e(C, delta) / e(A, B) Miller loop in affine
+                 * coordinates, which is faster than the projective verifier on curves with an affine pairing.
+                 */
+                template<typename CurveType>
+                class r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency {
+                    static_assert(has_affine_pairing<CurveType>::value,
+                                  "the pairing of this curve does not support affine coordinates");
+
+                    typedef detail::r1cs_gg_ppzksnark_basic_policy<CurveType, ProvingMode::Basic> policy_type;
+
+                    typedef typename CurveType::template g1_type<> g1_type;
+                    typedef typename CurveType::gt_type gt_type;
+                    typedef typename pairing::pairing_policy<CurveType>::affine_ate_g1_precomp affine_ate_g1_precomp;
+                    typedef typename pairing::pairing_policy<CurveType>::affine_ate_g2_precomp affine_ate_g2_precomp;
+
+                public:
+                    typedef typename policy_type::primary_input_type primary_input_type;
+                    typedef typename policy_type::verification_key_type verification_key_type;
+                    typedef typename policy_type::processed_verification_key_type processed_verification_key_type;
+                    typedef typename policy_type::proof_type proof_type;
+
+                    static inline bool process(const verification_key_type &verification_key,
+                                               const primary_input_type &primary_input,
+                                               const proof_type &proof) {
+
+                        assert(verification_key.gamma_ABC_g1.domain_size() >= primary_input.size());
+
+                        const affine_ate_g2_precomp pvk_vk_gamma_g2_precomp =
+                            affine_ate_precompute_g2<CurveType>(verification_key.gamma_g2);
+                        const affine_ate_g2_precomp pvk_vk_delta_g2_precomp =
+                            affine_ate_precompute_g2<CurveType>(verification_key.delta_g2);
+
+                        const typename g1_type::value_type acc =
+                            verification_key.gamma_ABC_g1.accumulate(primary_input.begin(), primary_input.end());
+
+                        bool result = true;
+
+                        if (!proof.is_well_formed()) {
+                            result = false;
+                        }
+
+                        const affine_ate_g1_precomp proof_g_A_precomp = affine_ate_precompute_g1<CurveType>(proof.g_A);
+                        const affine_ate_g2_precomp proof_g_B_precomp = affine_ate_precompute_g2<CurveType>(proof.g_B);
+                        const affine_ate_g1_precomp proof_g_C_precomp = affine_ate_precompute_g1<CurveType>(proof.g_C);
+                        const affine_ate_g1_precomp acc_precomp = affine_ate_precompute_g1<CurveType>(acc);
+
+                        const typename gt_type::value_type QAP_miller =
+                            affine_ate_e_times_e_over_e_miller_loop<CurveType>(
+                                acc_precomp, pvk_vk_gamma_g2_precomp, proof_g_C_precomp, pvk_vk_delta_g2_precomp,
+                                proof_g_A_precomp, proof_g_B_precomp);
+                        const typename gt_type::value_type QAP =
+                            final_exponentiation<CurveType>(QAP_miller.unitary_inversed());
+
+                        if (QAP != verification_key.alpha_g1_beta_g2) {
+                            result = false;
+                        }
+                        return result;
+                    }
+                };
             }    // namespace snark
         }        // namespace zk
     }            // namespace crypto3
@@ -97,6 +97,16 @@ namespace nil {
                         return Prover::process(pk, primary_input, auxiliary_input);
                     }
 
+                    // Prove reusing the buffers of a Prover::workspace_type created once for pk
+                    template<typename WorkspaceType>
+                    static inline proof_type prove(const proving_key_type &pk,
+                                                   const primary_input_type &primary_input,
+                                                   const auxiliary_input_type &auxiliary_input,
+                                                   WorkspaceType &workspace) {
+
+                        return Prover::process(pk, primary_input, auxiliary_input, workspace);
+                    }
+
                     static inline bool verify(const typename Verifier::verification_key_type &vk,
                                                const primary_input_type &primary_input,
                                                const proof_type &proof) {
@@ -37,6 +37,7 @@
 #include <nil/crypto3/zk/snark/commitments/knowledge_commitment.hpp>
 #include <nil/crypto3/zk/snark/commitments/knowledge_commitment_multiexp.hpp>
 #include <nil/crypto3/zk/snark/reductions/r1cs_to_qap.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/detail/multiexp_schedule.hpp>
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/r1cs_ppzksnark/detail/basic_policy.hpp>
 
 namespace nil {
@@ -70,18 +71,46 @@ namespace nil {
 
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * Buffers reused across proofs for one proving key, see r1cs_to_qap::workspace_type.
+                     */
+                    typedef typename reductions::r1cs_to_qap<scalar_field_type>::workspace_type workspace_type;
+
                     static inline proof_type process(const proving_key_type &proving_key,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        workspace_type workspace(proving_key.constraint_system);
+
+                        return process(proving_key, primary_input, auxiliary_input, workspace);
+                    }
+
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     workspace_type &workspace,
+                                                     multiexp_schedule schedule = multiexp_schedule::sequential) {
 
                         const typename scalar_field_type::value_type d1 = algebra::random_element<scalar_field_type>(),
                                                                      d2 = algebra::random_element<scalar_field_type>(),
                                                                      d3 = algebra::random_element<scalar_field_type>();
 
-                        const qap_witness<scalar_field_type> qap_wit =
-                            reductions::r1cs_to_qap<scalar_field_type>::witness_map(proving_key.constraint_system, primary_input,
-                                                                                    auxiliary_input, d1, d2, d3);
+                        const qap_witness<scalar_field_type> &qap_wit =
+                            reductions::r1cs_to_qap<scalar_field_type>::witness_map(
+                                proving_key.constraint_system, primary_input, auxiliary_input, d1, d2, d3, workspace);
+
+                        return process(proving_key, qap_wit, schedule);
+                    }
 
+                    /**
+                     * Prove from a QAP witness computed for proving_key.constraint_system with random d1, d2, d3,
+                     * e.g. by r1cs_to_qap::witness_map_from_evaluations().
+                     *
+                     * With multiexp_schedule::concurrent the five multi-exponentiations are split into pieces
+                     * that all run in one parallel loop, instead of one chunked multi-exponentiation at a time.
+                     */
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const qap_witness<scalar_field_type> &qap_wit,
+                                                     multiexp_schedule schedule = multiexp_schedule::sequential) {
                         typename knowledge_commitment<g1_type, g1_type>::value_type g_A =
                             proving_key.A_query[0] + qap_wit.d1 * proving_key.A_query[qap_wit.num_variables + 1];
                         typename knowledge_commitment<g2_type, g1_type>::value_type g_B =
@@ -101,6 +130,44 @@ namespace nil {
                         const std::size_t chunks = 1;
 #endif
 
+                        if (schedule == multiexp_schedule::concurrent) {
+                            detail::concurrent_multiexps multiexps(chunks);
+                            const auto &scalars = qap_wit.coefficients_for_ABCs;
+
+                            multiexps.add(g_A, qap_wit.num_variables, [&](std::size_t first, std::size_t last) {
+                                return kc_multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.A_query, 1 + first, 1 + last, scalars.begin() + first,
+                                    scalars.begin() + last, 1);
+                            });
+                            multiexps.add(g_B, qap_wit.num_variables, [&](std::size_t first, std::size_t last) {
+                                return kc_multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.B_query, 1 + first, 1 + last, scalars.begin() + first,
+                                    scalars.begin() + last, 1);
+                            });
+                            multiexps.add(g_C, qap_wit.num_variables, [&](std::size_t first, std::size_t last) {
+                                return kc_multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.C_query, 1 + first, 1 + last, scalars.begin() + first,
+                                    scalars.begin() + last, 1);
+                            });
+                            multiexps.add(g_H, qap_wit.degree + 1, [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.H_query.begin() + first, proving_key.H_query.begin() + last,
+                                    qap_wit.coefficients_for_H.begin() + first,
+                                    qap_wit.coefficients_for_H.begin() + last, 1);
+                            });
+                            multiexps.add(g_K, qap_wit.num_variables, [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp_with_mixed_addition<
+                                    algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.K_query.begin() + 1 + first, proving_key.K_query.begin() + 1 + last,
+                                    scalars.begin() + first, scalars.begin() + last, 1);
+                            });
+
+                            multiexps.run();
+
+                            return proof_type(std::move(g_A), std::move(g_B), std::move(g_C), std::move(g_H),
+                                              std::move(g_K));
+                        }
+
                         g_A = g_A + kc_multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
                                         proving_key.A_query, 1, 1 + qap_wit.num_variables,
                                         qap_wit.coefficients_for_ABCs.begin(),
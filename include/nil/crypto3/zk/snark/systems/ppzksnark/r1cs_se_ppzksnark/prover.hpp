@@ -36,6 +36,7 @@
 
 #include <nil/crypto3/zk/snark/reductions/r1cs_to_sap.hpp>
 #include <nil/crypto3/zk/snark/relations/arithmetic_programs/sap.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/detail/multiexp_schedule.hpp>
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/r1cs_se_ppzksnark/detail/basic_policy.hpp>
 
 namespace nil {
@@ -67,17 +68,33 @@ namespace nil {
                     typedef typename policy_type::keypair_type keypair_type;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * Buffers reused across proofs for one proving key, see r1cs_to_sap::workspace_type.
+                     */
+                    typedef typename reductions::r1cs_to_sap<typename CurveType::scalar_field_type>::workspace_type
+                        workspace_type;
+
                     static inline proof_type process(const proving_key_type &proving_key,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        workspace_type workspace(proving_key.constraint_system);
+
+                        return process(proving_key, primary_input, auxiliary_input, workspace);
+                    }
+
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     workspace_type &workspace,
+                                                     multiexp_schedule schedule = multiexp_schedule::sequential) {
 
                         const typename CurveType::scalar_field_type::value_type
                             d1 = algebra::random_element<typename CurveType::scalar_field_type>(),
                             d2 = algebra::random_element<typename CurveType::scalar_field_type>();
 
-                        const sap_witness<typename CurveType::scalar_field_type> sap_wit =
+                        const sap_witness<typename CurveType::scalar_field_type> &sap_wit =
                             reductions::r1cs_to_sap<typename CurveType::scalar_field_type>::witness_map(
-                                proving_key.constraint_system, primary_input, auxiliary_input, d1, d2);
+                                proving_key.constraint_system, primary_input, auxiliary_input, d1, d2, workspace);
 
 #ifdef MULTICORE
                         const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
@@ -89,36 +106,92 @@ namespace nil {
                         const typename CurveType::scalar_field_type::value_type r =
                             algebra::random_element<typename CurveType::scalar_field_type>();
 
+                        typedef typename CurveType::template g1_type<>::value_type g1_value_type;
+                        typedef typename CurveType::template g2_type<>::value_type g2_value_type;
+
+                        /**
+                         * The five multi-exponentiations below only depend on the witness. With
+                         * multiexp_schedule::concurrent they are split into pieces that all run in one parallel
+                         * loop, instead of one chunked multi-exponentiation at a time.
+                         */
+                        const auto &scalars = sap_wit.coefficients_for_ACs;
+                        g1_value_type A_multiexp = g1_value_type::zero(), C_1_multiexp = g1_value_type::zero(),
+                                      C_2_multiexp = g1_value_type::zero(), H_multiexp = g1_value_type::zero();
+                        g2_value_type B_multiexp = g2_value_type::zero();
+
+                        if (schedule == multiexp_schedule::concurrent) {
+                            detail::concurrent_multiexps multiexps(chunks);
+
+                            multiexps.add(A_multiexp, scalars.size(), [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.A_query.begin() + 1 + first, proving_key.A_query.begin() + 1 + last,
+                                    scalars.begin() + first, scalars.begin() + last, 1);
+                            });
+                            multiexps.add(B_multiexp, scalars.size(), [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.B_query.begin() + 1 + first, proving_key.B_query.begin() + 1 + last,
+                                    scalars.begin() + first, scalars.begin() + last, 1);
+                            });
+                            multiexps.add(C_1_multiexp, proving_key.C_query_1.size(),
+                                          [&](std::size_t first, std::size_t last) {
+                                              return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                                  proving_key.C_query_1.begin() + first,
+                                                  proving_key.C_query_1.begin() + last,
+                                                  scalars.begin() + sap_wit.num_inputs + first,
+                                                  scalars.begin() + sap_wit.num_inputs + last, 1);
+                                          });
+                            multiexps.add(C_2_multiexp, scalars.size(), [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.C_query_2.begin() + 1 + first,
+                                    proving_key.C_query_2.begin() + 1 + last, scalars.begin() + first,
+                                    scalars.begin() + last, 1);
+                            });
+                            multiexps.add(H_multiexp, proving_key.G_gamma2_Z_t.size(),
+                                          [&](std::size_t first, std::size_t last) {
+                                              return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                                  proving_key.G_gamma2_Z_t.begin() + first,
+                                                  proving_key.G_gamma2_Z_t.begin() + last,
+                                                  sap_wit.coefficients_for_H.begin() + first,
+                                                  sap_wit.coefficients_for_H.begin() + last, 1);
+                                          });
+
+                            multiexps.run();
+                        } else {
+                            A_multiexp = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                proving_key.A_query.begin() + 1, proving_key.A_query.end(), scalars.begin(),
+                                scalars.end(), chunks);
+                            B_multiexp = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                proving_key.B_query.begin() + 1, proving_key.B_query.end(), scalars.begin(),
+                                scalars.end(), chunks);
+                            C_1_multiexp = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                proving_key.C_query_1.begin(), proving_key.C_query_1.end(),
+                                scalars.begin() + sap_wit.num_inputs, scalars.end(), chunks);
+                            C_2_multiexp = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                proving_key.C_query_2.begin() + 1, proving_key.C_query_2.end(), scalars.begin(),
+                                scalars.end(), chunks);
+                            H_multiexp = algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                proving_key.G_gamma2_Z_t.begin(), proving_key.G_gamma2_Z_t.end(),
+                                sap_wit.coefficients_for_H.begin(), sap_wit.coefficients_for_H.end(), chunks);
+                        }
+
                         /**
                          * compute A = G^{gamma * (\sum_{i=0}^m input_i * A_i(t) + r * Z(t))}
                          *           = \prod_{i=0}^m (G^{gamma * A_i(t)})^{input_i)
                          *             * (G^{gamma * Z(t)})^r
                          *           = \prod_{i=0}^m A_query[i]^{input_i} * G_gamma_Z^r
                          */
-                        typename CurveType::template g1_type<>::value_type A =
-                            r * proving_key.G_gamma_Z +
-                            proving_key.A_query[0] +                // i = 0 is a special case because input_i = 1
-                            sap_wit.d1 * proving_key.G_gamma_Z +    // ZK-patch
-                            algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.A_query.begin() + 1,
-                                proving_key.A_query.end(),
-                                sap_wit.coefficients_for_ACs.begin(),
-                                sap_wit.coefficients_for_ACs.end(),
-                                chunks);
+                        g1_value_type A = r * proving_key.G_gamma_Z +
+                                          proving_key.A_query[0] +    // i = 0 is a special case because input_i = 1
+                                          sap_wit.d1 * proving_key.G_gamma_Z +    // ZK-patch
+                                          A_multiexp;
 
                         /**
                          * compute B exactly as A, except with H as the base
                          */
-                        typename CurveType::template g2_type<>::value_type B =
-                            r * proving_key.H_gamma_Z +
-                            proving_key.B_query[0] +                // i = 0 is a special case because input_i = 1
-                            sap_wit.d1 * proving_key.H_gamma_Z +    // ZK-patch
-                            algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.B_query.begin() + 1,
-                                proving_key.B_query.end(),
-                                sap_wit.coefficients_for_ACs.begin(),
-                                sap_wit.coefficients_for_ACs.end(),
-                                chunks);
+                        g2_value_type B = r * proving_key.H_gamma_Z +
+                                          proving_key.B_query[0] +    // i = 0 is a special case because input_i = 1
+                                          sap_wit.d1 * proving_key.H_gamma_Z +    // ZK-patch
+                                          B_multiexp;
                         /**
                          * compute C = G^{f(input) +
                          *                r^2 * gamma^2 * Z(t)^2 +
@@ -129,30 +202,14 @@ namespace nil {
                          * and G^{2 * r * gamma^2 * Z(t) * \sum_{i=0}^m input_i A_i(t)} =
                          *              = \prod_{i=0}^m C_query_2 * input_i
                          */
-                        typename CurveType::template g1_type<>::value_type C =
-                            algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.C_query_1.begin(),
-                                proving_key.C_query_1.end(),
-                                sap_wit.coefficients_for_ACs.begin() + sap_wit.num_inputs,
-                                sap_wit.coefficients_for_ACs.end(),
-                                chunks) +
-                            (r * r) * proving_key.G_gamma2_Z2 + r * proving_key.G_ab_gamma_Z +
-                            sap_wit.d1 * proving_key.G_ab_gamma_Z +             // ZK-patch
-                            r * proving_key.C_query_2[0] +                      // i = 0 is a special case for C_query_2
-                            (r + r) * sap_wit.d1 * proving_key.G_gamma2_Z2 +    // ZK-patch for C_query_2
-                            r * algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                    proving_key.C_query_2.begin() + 1,
-                                    proving_key.C_query_2.end(),
-                                    sap_wit.coefficients_for_ACs.begin(),
-                                    sap_wit.coefficients_for_ACs.end(),
-                                    chunks) +
-                            sap_wit.d2 * proving_key.G_gamma2_Z_t[0] +    // ZK-patch
-                            algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
-                                proving_key.G_gamma2_Z_t.begin(),
-                                proving_key.G_gamma2_Z_t.end(),
-                                sap_wit.coefficients_for_H.begin(),
-                                sap_wit.coefficients_for_H.end(),
-                                chunks);
+                        g1_value_type C = C_1_multiexp + (r * r) * proving_key.G_gamma2_Z2 +
+                                          r * proving_key.G_ab_gamma_Z +
+                                          sap_wit.d1 * proving_key.G_ab_gamma_Z +    // ZK-patch
+                                          r * proving_key.C_query_2[0] +    // i = 0 is a special case for C_query_2
+                                          (r + r) * sap_wit.d1 * proving_key.G_gamma2_Z2 +    // ZK-patch for C_query_2
+                                          r * C_2_multiexp +
+                                          sap_wit.d2 * proving_key.G_gamma2_Z_t[0] +    // ZK-patch
+                                          H_multiexp;
 
                         return {std::move(A), std::move(B), std::move(C)};
                     }
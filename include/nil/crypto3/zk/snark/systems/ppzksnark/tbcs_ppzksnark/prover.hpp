@@ -26,8 +26,19 @@
 #ifndef CRYPTO3_ZK_TBCS_PPZKSNARK_BASIC_PROVER_HPP
 #define CRYPTO3_ZK_TBCS_PPZKSNARK_BASIC_PROVER_HPP
 
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#include <nil/crypto3/algebra/random_element.hpp>
+
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/uscs.hpp>
 #include <nil/crypto3/zk/snark/reductions/tbcs_to_uscs.hpp>
+#include <nil/crypto3/zk/snark/reductions/uscs_to_ssp.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/uscs_ppzksnark/prover.hpp>
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/uscs_ppzksnark.hpp>
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/tbcs_ppzksnark/detail/basic_policy.hpp>
 #include <nil/crypto3/zk/snark/algorithms/prove.hpp>
@@ -61,20 +72,93 @@ namespace nil {
                     typedef typename policy_type::keypair_type keypair_type;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * Buffers reused across proofs for one proving key, see uscs_to_ssp::workspace_type.
+                     */
+                    typedef typename uscs_ppzksnark_prover<CurveType>::workspace_type workspace_type;
+
                     static inline proof_type process(const proving_key_type &pk,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        workspace_type workspace(pk.uscs_pk.constraint_system);
+
+                        return process(pk, primary_input, auxiliary_input, workspace);
+                    }
+
+                    /**
+                     * The circuit is evaluated straight into the SSP witness, so the wires are not converted
+                     * into a separate USCS assignment and copied again into the primary and auxiliary inputs.
+                     */
+                    static inline proof_type process(const proving_key_type &pk,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     workspace_type &workspace) {
                         typedef typename CurveType::scalar_field_type FieldType;
 
-                        const uscs_variable_assignment<FieldType> uscs_va =
-                            reductions::tbcs_to_uscs<FieldType>::witness_map(pk.circuit, primary_input, auxiliary_input);
-                        const uscs_primary_input<FieldType> uscs_pi =
-                            algebra::convert_bit_vector_to_field_element_vector<FieldType>(primary_input);
-                        const uscs_auxiliary_input<FieldType> uscs_ai(
-                            uscs_va.begin() + primary_input.size(),
-                            uscs_va.end());    // TODO: faster to just change bacs_to_r1cs<field_type>::witness_map into two :(
+                        assert(pk.circuit.is_satisfied(primary_input, auxiliary_input));
+
+                        const typename FieldType::value_type d = algebra::random_element<FieldType>();
+
+                        reductions::tbcs_to_uscs<FieldType>::witness_map(pk.circuit, primary_input, auxiliary_input,
+                                                                         workspace);
+                        const ssp_witness<FieldType> &ssp_wit =
+                            reductions::uscs_to_ssp<FieldType>::witness_map_from_assignment(
+                                pk.uscs_pk.constraint_system, d, workspace);
+
+                        return uscs_ppzksnark_prover<CurveType>::process(pk.uscs_pk, ssp_wit);
+                    }
+
+                    /**
+                     * Prove many statements with one key, spreading the proofs over the threads with one
+                     * workspace each; see uscs_ppzksnark_prover.
+                     */
+                    static inline std::vector<proof_type>
+                        process(const proving_key_type &pk,
+                                const std::vector<primary_input_type> &primary_inputs,
+                                const std::vector<auxiliary_input_type> &auxiliary_inputs) {
+                        typedef typename CurveType::scalar_field_type FieldType;
+                        assert(primary_inputs.size() == auxiliary_inputs.size());
+
+                        const std::size_t num_proofs = primary_inputs.size();
+
+                        std::vector<typename FieldType::value_type> ds;
+                        ds.reserve(num_proofs);
+                        for (std::size_t i = 0; i < num_proofs; ++i) {
+                            ds.emplace_back(algebra::random_element<FieldType>());
+                        }
+
+#ifdef MULTICORE
+                        const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                             // var or call omp_set_num_threads()
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t num_workspaces = std::min(chunks, num_proofs);
+                        std::vector<workspace_type> workspaces;
+                        workspaces.reserve(num_workspaces);
+                        for (std::size_t c = 0; c < num_workspaces; ++c) {
+                            workspaces.emplace_back(pk.uscs_pk.constraint_system);
+                        }
+
+                        std::vector<proof_type> proofs(num_proofs);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < num_workspaces; ++c) {
+                            for (std::size_t i = c; i < num_proofs; i += num_workspaces) {
+                                assert(pk.circuit.is_satisfied(primary_inputs[i], auxiliary_inputs[i]));
+
+                                reductions::tbcs_to_uscs<FieldType>::witness_map(pk.circuit, primary_inputs[i],
+                                                                                 auxiliary_inputs[i], workspaces[c]);
+                                const ssp_witness<FieldType> &ssp_wit =
+                                    reductions::uscs_to_ssp<FieldType>::witness_map_from_assignment(
+                                        pk.uscs_pk.constraint_system, ds[i], workspaces[c]);
+
+                                proofs[i] = uscs_ppzksnark_prover<CurveType>::process(pk.uscs_pk, ssp_wit);
+                            }
+                        }
 
-                        return prove<uscs_ppzksnark<CurveType>>(pk.uscs_pk, uscs_pi, uscs_ai);
+                        return proofs;
                     }
                 };
             }    // namespace snark
@@ -30,6 +30,9 @@
 #include <omp.h>
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #include <nil/crypto3/algebra/multiexp/multiexp.hpp>
 #include <nil/crypto3/algebra/multiexp/policies.hpp>
 #include <nil/crypto3/algebra/random_element.hpp>
@@ -37,6 +40,7 @@
 #include <nil/crypto3/zk/snark/relations/arithmetic_programs/ssp.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/uscs.hpp>
 #include <nil/crypto3/zk/snark/reductions/uscs_to_ssp.hpp>
+#include <nil/crypto3/zk/snark/systems/ppzksnark/detail/multiexp_schedule.hpp>
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/uscs_ppzksnark/detail/basic_policy.hpp>
 
 namespace nil {
@@ -64,34 +68,128 @@ namespace nil {
                     typedef typename policy_type::proving_key_type proving_key_type;;
                     typedef typename policy_type::proof_type proof_type;
 
+                    /**
+                     * Buffers reused across proofs for one proving key, see uscs_to_ssp::workspace_type.
+                     */
+                    typedef typename reductions::uscs_to_ssp<typename CurveType::scalar_field_type>::workspace_type
+                        workspace_type;
+
                     static inline proof_type process(const proving_key_type &proving_key,
                                                      const primary_input_type &primary_input,
                                                      const auxiliary_input_type &auxiliary_input) {
+                        workspace_type workspace(proving_key.constraint_system);
+
+                        return process(proving_key, primary_input, auxiliary_input, workspace);
+                    }
+
+                    static inline proof_type process(const proving_key_type &proving_key,
+                                                     const primary_input_type &primary_input,
+                                                     const auxiliary_input_type &auxiliary_input,
+                                                     workspace_type &workspace,
+                                                     multiexp_schedule schedule = multiexp_schedule::sequential) {
 
                         const typename CurveType::scalar_field_type::value_type d =
                             algebra::random_element<typename CurveType::scalar_field_type>();
 
-                        const ssp_witness<typename CurveType::scalar_field_type> ssp_wit =
+                        const ssp_witness<typename CurveType::scalar_field_type> &ssp_wit =
                             reductions::uscs_to_ssp<typename CurveType::scalar_field_type>::witness_map(
-                                proving_key.constraint_system, primary_input, auxiliary_input, d);
+                                proving_key.constraint_system, primary_input, auxiliary_input, d, workspace);
 
-                        /* sanity checks */
-                        assert(proving_key.constraint_system.is_satisfied(primary_input, auxiliary_input));
-                        assert(proving_key.V_g1_query.size() == ssp_wit.num_variables + 2 - ssp_wit.num_inputs - 1);
-                        assert(proving_key.alpha_V_g1_query.size() ==
-                               ssp_wit.num_variables + 2 - ssp_wit.num_inputs - 1);
-                        assert(proving_key.H_g1_query.size() == ssp_wit.degree + 1);
-                        assert(proving_key.V_g2_query.size() == ssp_wit.num_variables + 2);
+                        return process(proving_key, ssp_wit, schedule);
+                    }
+
+                    /**
+                     * Prove many statements with one key. The proofs are spread over the threads, each with its
+                     * own witness map workspace; the randomness is drawn beforehand on the calling thread, so the
+                     * random generator is not shared between threads.
+                     */
+                    static inline std::vector<proof_type>
+                        process(const proving_key_type &proving_key,
+                                const std::vector<primary_input_type> &primary_inputs,
+                                const std::vector<auxiliary_input_type> &auxiliary_inputs) {
+                        typedef typename CurveType::scalar_field_type scalar_field_type;
+                        assert(primary_inputs.size() == auxiliary_inputs.size());
+
+                        const std::size_t num_proofs = primary_inputs.size();
+
+                        std::vector<typename scalar_field_type::value_type> ds;
+                        ds.reserve(num_proofs);
+                        for (std::size_t i = 0; i < num_proofs; ++i) {
+                            ds.emplace_back(algebra::random_element<scalar_field_type>());
+                        }
+
+#ifdef MULTICORE
+                        const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
+                                                                             // var or call omp_set_num_threads()
+#else
+                        const std::size_t chunks = 1;
+#endif
+                        const std::size_t num_workspaces = std::min(chunks, num_proofs);
+                        std::vector<workspace_type> workspaces;
+                        workspaces.reserve(num_workspaces);
+                        for (std::size_t c = 0; c < num_workspaces; ++c) {
+                            workspaces.emplace_back(proving_key.constraint_system);
+                        }
+
+                        std::vector<proof_type> proofs(num_proofs);
+#ifdef MULTICORE
+#pragma omp parallel for
+#endif
+                        for (std::size_t c = 0; c < num_workspaces; ++c) {
+                            for (std::size_t i = c; i < num_proofs; i += num_workspaces) {
+                                const ssp_witness<scalar_field_type> &ssp_wit =
+                                    reductions::uscs_to_ssp<scalar_field_type>::witness_map(
+                                        proving_key.constraint_system, primary_inputs[i], auxiliary_inputs[i], ds[i],
+                                        workspaces[c]);
+
+                                proofs[i] = process(proving_key, ssp_wit);
+                            }
+                        }
+
+                        return proofs;
+                    }
 
+                    /**
+                     * Prove from a SSP witness computed for proving_key.constraint_system with a random d, e.g. by
+                     * uscs_to_ssp::witness_map_from_assignment().
+                     *
+                     * With multiexp_schedule::concurrent the four multi-exponentiations are split into pieces
+                     * that all run in one parallel loop, instead of one chunked multi-exponentiation at a time.
+                     */
+                    static inline proof_type
+                        process(const proving_key_type &proving_key,
+                                const ssp_witness<typename CurveType::scalar_field_type> &ssp_wit,
+                                multiexp_schedule schedule = multiexp_schedule::sequential) {
                         typename g1_type::value_type V_g1 =
                             ssp_wit.d * proving_key.V_g1_query[proving_key.V_g1_query.size() - 1];
                         typename g1_type::value_type alpha_V_g1 =
                             ssp_wit.d * proving_key.alpha_V_g1_query[proving_key.alpha_V_g1_query.size() - 1];
-                        typename g1_type::value_type H_g1 = g1_type::value_type::zero();
                         typename g2_type::value_type V_g2 =
                             proving_key.V_g2_query[0] +
                             ssp_wit.d * proving_key.V_g2_query[proving_key.V_g2_query.size() - 1];
 
+                        return add_multiexps(proving_key, ssp_wit, std::move(V_g1), std::move(alpha_V_g1),
+                                             std::move(V_g2), schedule);
+                    }
+
+                private:
+                    /* the proof elements, given their zero-knowledge patch */
+                    static inline proof_type
+                        add_multiexps(const proving_key_type &proving_key,
+                                      const ssp_witness<typename CurveType::scalar_field_type> &ssp_wit,
+                                      typename g1_type::value_type &&V_g1,
+                                      typename g1_type::value_type &&alpha_V_g1,
+                                      typename g2_type::value_type &&V_g2,
+                                      multiexp_schedule schedule) {
+                        /* sanity checks */
+                        assert(proving_key.V_g1_query.size() == ssp_wit.num_variables + 2 - ssp_wit.num_inputs - 1);
+                        assert(proving_key.alpha_V_g1_query.size() ==
+                               ssp_wit.num_variables + 2 - ssp_wit.num_inputs - 1);
+                        assert(proving_key.H_g1_query.size() == ssp_wit.degree + 1);
+                        assert(proving_key.V_g2_query.size() == ssp_wit.num_variables + 2);
+
+                        typename g1_type::value_type H_g1 = g1_type::value_type::zero();
+
 #ifdef MULTICORE
                         const std::size_t chunks = omp_get_max_threads();    // to override, set OMP_NUM_THREADS env
                                                                              // var or call omp_set_num_threads()
@@ -99,7 +197,45 @@ namespace nil {
                         const std::size_t chunks = 1;
 #endif
 
-                        // MAYBE LATER: do queries 1,2,4 at once for slightly better speed
+                        if (schedule == multiexp_schedule::concurrent) {
+                            detail::concurrent_multiexps multiexps(chunks);
+                            const auto witness_begin = ssp_wit.coefficients_for_Vs.begin();
+                            const std::size_t num_witness = ssp_wit.num_variables - ssp_wit.num_inputs;
+
+                            multiexps.add(V_g1, num_witness, [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp_with_mixed_addition<
+                                    algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.V_g1_query.begin() + first, proving_key.V_g1_query.begin() + last,
+                                    witness_begin + ssp_wit.num_inputs + first,
+                                    witness_begin + ssp_wit.num_inputs + last, 1);
+                            });
+                            multiexps.add(alpha_V_g1, num_witness, [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp_with_mixed_addition<
+                                    algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.alpha_V_g1_query.begin() + first,
+                                    proving_key.alpha_V_g1_query.begin() + last,
+                                    witness_begin + ssp_wit.num_inputs + first,
+                                    witness_begin + ssp_wit.num_inputs + last, 1);
+                            });
+                            multiexps.add(H_g1, ssp_wit.degree + 1, [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.H_g1_query.begin() + first, proving_key.H_g1_query.begin() + last,
+                                    ssp_wit.coefficients_for_H.begin() + first,
+                                    ssp_wit.coefficients_for_H.begin() + last, 1);
+                            });
+                            multiexps.add(V_g2, ssp_wit.num_variables, [&](std::size_t first, std::size_t last) {
+                                return algebra::multiexp<algebra::policies::multiexp_method_BDLO12>(
+                                    proving_key.V_g2_query.begin() + 1 + first,
+                                    proving_key.V_g2_query.begin() + 1 + last, witness_begin + first,
+                                    witness_begin + last, 1);
+                            });
+
+                            multiexps.run();
+
+                            return proof_type(std::move(V_g1), std::move(alpha_V_g1), std::move(H_g1),
+                                              std::move(V_g2));
+                        }
+
 
                         V_g1 = V_g1 + algebra::multiexp_with_mixed_addition<algebra::policies::multiexp_method_BDLO12>(
                                           proving_key.V_g1_query.begin(),
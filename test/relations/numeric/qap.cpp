@@ -36,6 +36,7 @@
 
 #include <nil/crypto3/zk/snark/reductions/r1cs_to_qap.hpp>
 #include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs.hpp>
+#include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs_optimizer.hpp>
 
 #include <nil/crypto3/algebra/random_element.hpp>
 #include <nil/crypto3/algebra/curves/mnt4.hpp>
@@ -89,6 +90,19 @@ void test_qap(const std::size_t qap_degree, const std::size_t num_inputs, const
 
     std::cout << "Constraint system satisfied" << std::endl;
 
+    /**
+     * the selected domain is a radix-2 one fitting the instance, never larger than the domain of
+     * make_evaluation_domain(); the sizes of qap_test_case cover every selectable kind
+     */
+    const reductions::detail::domain_choice choice =
+        reductions::r1cs_to_qap<FieldType>::get_domain_choice(example.constraint_system);
+    BOOST_CHECK(choice.kind == reductions::detail::domain_kind::basic_radix2 ||
+                choice.kind == reductions::detail::domain_kind::extended_radix2 ||
+                choice.kind == reductions::detail::domain_kind::step_radix2);
+    BOOST_CHECK(choice.size >= qap_degree);
+    BOOST_CHECK(choice.size <= nil::crypto3::math::make_evaluation_domain<FieldType>(qap_degree)->m);
+    BOOST_CHECK_EQUAL(reductions::r1cs_to_qap<FieldType>::get_domain(example.constraint_system)->m, choice.size);
+
     const typename FieldType::value_type t = random_element<FieldType>(),
                                          d1 = random_element<FieldType>(),
                                          d2 = random_element<FieldType>(),
@@ -124,6 +138,89 @@ void test_qap(const std::size_t qap_degree, const std::size_t num_inputs, const
 
     BOOST_CHECK(qap_inst_1.is_satisfied(qap_wit));
     BOOST_CHECK(qap_inst_2.is_satisfied(qap_wit));
+
+    /* the sparse Lagrange basis columns evaluate to the same values as the direct evaluation */
+    const std::vector<typename FieldType::value_type> u = qap_inst_1.domain->evaluate_all_lagrange_polynomials(t);
+    BOOST_CHECK(qap_inst_1.A_in_Lagrange_basis.evaluate(u) == qap_inst_2.At);
+    BOOST_CHECK(qap_inst_1.B_in_Lagrange_basis.evaluate(u) == qap_inst_2.Bt);
+    BOOST_CHECK(qap_inst_1.C_in_Lagrange_basis.evaluate(u) == qap_inst_2.Ct);
+
+    /* a reused workspace yields the same witness as a fresh witness map */
+    typename reductions::r1cs_to_qap<FieldType>::workspace_type workspace(example.constraint_system);
+    for (std::size_t i = 0; i < 2; ++i) {
+        const qap_witness<FieldType> &reused_wit = reductions::r1cs_to_qap<FieldType>::witness_map(
+            example.constraint_system, example.primary_input, example.auxiliary_input, d1, d2, d3, workspace);
+        BOOST_CHECK(reused_wit.coefficients_for_ABCs == qap_wit.coefficients_for_ABCs);
+        BOOST_CHECK(reused_wit.coefficients_for_H == qap_wit.coefficients_for_H);
+    }
+
+    /* the memory-bounded witness map yields the same witness with or without the coset tables */
+    const std::size_t table_bytes =
+        reductions::r1cs_to_qap<FieldType>::witness_map_peak_bytes(example.constraint_system, true, true);
+    for (std::size_t memory_budget : {std::size_t(0), table_bytes}) {
+        std::size_t peak_bytes = 0;
+        qap_witness<FieldType> bounded_wit = reductions::r1cs_to_qap<FieldType>::witness_map_with_memory_budget(
+            example.constraint_system, example.primary_input, example.auxiliary_input, d1, d2, d3, memory_budget,
+            peak_bytes);
+        BOOST_CHECK(bounded_wit.coefficients_for_ABCs == qap_wit.coefficients_for_ABCs);
+        BOOST_CHECK(bounded_wit.coefficients_for_H == qap_wit.coefficients_for_H);
+        BOOST_CHECK_EQUAL(peak_bytes, reductions::r1cs_to_qap<FieldType>::witness_map_peak_bytes(
+                                          example.constraint_system, true, memory_budget >= table_bytes));
+    }
+
+    /* without the ZK patch, H is computed in place */
+    const typename FieldType::value_type zero = FieldType::value_type::zero();
+    std::size_t peak_bytes = 0;
+    qap_witness<FieldType> unpatched_wit = reductions::r1cs_to_qap<FieldType>::witness_map_with_memory_budget(
+        example.constraint_system, example.primary_input, example.auxiliary_input, zero, zero, zero, 0, peak_bytes);
+    BOOST_CHECK(unpatched_wit.coefficients_for_H ==
+                reductions::r1cs_to_qap<FieldType>::witness_map(example.constraint_system, example.primary_input,
+                                                                example.auxiliary_input, zero, zero, zero)
+                    .coefficients_for_H);
+    BOOST_CHECK_EQUAL(peak_bytes, reductions::r1cs_to_qap<FieldType>::witness_map_peak_bytes(
+                                      example.constraint_system, false, false));
+}
+
+template<typename FieldType>
+void test_qap_with_optimized_r1cs() {
+    typedef typename FieldType::value_type value_type;
+
+    /* x1 is the primary input, x2..x9 are auxiliary; x8 is never referenced */
+    const variable<FieldType> one(0), x1(1), x2(2), x3(3), x4(4), x5(5), x6(6), x7(7), x9(9);
+
+    r1cs_constraint_system<FieldType> cs;
+    cs.primary_input_size = 1;
+    cs.auxiliary_input_size = 8;
+    cs.add_constraint(r1cs_constraint<FieldType>(x2, x2, x3));
+    /* duplicate terms and an alias: x4 = x3 */
+    cs.add_constraint(r1cs_constraint<FieldType>(one, linear_combination<FieldType>({x3 * 1, x3 * 1, x3 * (-1)}), x4));
+    cs.add_constraint(r1cs_constraint<FieldType>(x4, x1, x5));
+    /* linear constraints: x6 = x5 + 5, x7 = x6 */
+    cs.add_constraint(r1cs_constraint<FieldType>(one, x5 + linear_combination<FieldType>(5), x6));
+    cs.add_constraint(r1cs_constraint<FieldType>(x6, one, x7));
+    cs.add_constraint(r1cs_constraint<FieldType>(x7, x7, x9));
+
+    const r1cs_primary_input<FieldType> primary_input = {value_type(3)};
+    const r1cs_auxiliary_input<FieldType> auxiliary_input = {value_type(2),  value_type(4),  value_type(4),
+                                                             value_type(12), value_type(17), value_type(17),
+                                                             value_type(42), value_type(289)};
+    BOOST_CHECK(cs.is_satisfied(primary_input, auxiliary_input));
+
+    const r1cs_optimized_constraint_system<FieldType> optimized = r1cs_optimizer<FieldType>::process(cs);
+    BOOST_CHECK(optimized.constraint_system.is_valid());
+    BOOST_CHECK_EQUAL(optimized.constraint_system.num_inputs(), cs.num_inputs());
+    BOOST_CHECK_EQUAL(optimized.constraint_system.num_constraints(), 3);
+    BOOST_CHECK_EQUAL(optimized.constraint_system.num_variables(), 5);
+
+    const r1cs_auxiliary_input<FieldType> optimized_auxiliary_input = optimized.auxiliary_input_map(auxiliary_input);
+    BOOST_CHECK(optimized.constraint_system.is_satisfied(primary_input, optimized_auxiliary_input));
+
+    const value_type d1 = random_element<FieldType>(), d2 = random_element<FieldType>(),
+                     d3 = random_element<FieldType>();
+    qap_instance<FieldType> qap_inst = reductions::r1cs_to_qap<FieldType>::instance_map(optimized.constraint_system);
+    qap_witness<FieldType> qap_wit = reductions::r1cs_to_qap<FieldType>::witness_map(
+        optimized.constraint_system, primary_input, optimized_auxiliary_input, d1, d2, d3);
+    BOOST_CHECK(qap_inst.is_satisfied(qap_wit));
 }
 
 BOOST_AUTO_TEST_SUITE(qap_test_suite)
@@ -137,16 +234,28 @@ BOOST_AUTO_TEST_CASE(qap_test_case) {
     const std::size_t step_domain_size = (1ul << 10) + (1ul << 8);
     const std::size_t extended_domain_size = 1ul << (fields::arithmetic_params<basic_curve_type::scalar_field_type>::s + 1);
     const std::size_t extended_domain_size_special = extended_domain_size - 1;
+    /* not a step domain size itself: the selection rounds it up to the step domain of size 2^10 + 2^8 */
+    const std::size_t rounded_step_domain_size = (1ul << 10) + 200;
+    BOOST_CHECK_EQUAL(
+        (reductions::detail::domain_selection<basic_curve_type::scalar_field_type>::select(rounded_step_domain_size, 7)
+             .size),
+        step_domain_size);
 
     test_qap<typename basic_curve_type::scalar_field_type>(basic_domain_size, num_inputs, true);
     test_qap<typename basic_curve_type::scalar_field_type>(step_domain_size, num_inputs, true);
     test_qap<typename basic_curve_type::scalar_field_type>(extended_domain_size, num_inputs, true);
     test_qap<typename basic_curve_type::scalar_field_type>(extended_domain_size_special, num_inputs, true);
+    test_qap<typename basic_curve_type::scalar_field_type>(rounded_step_domain_size, num_inputs, true);
 
     test_qap<typename basic_curve_type::scalar_field_type>(basic_domain_size, num_inputs, false);
     test_qap<typename basic_curve_type::scalar_field_type>(step_domain_size, num_inputs, false);
     test_qap<typename basic_curve_type::scalar_field_type>(extended_domain_size, num_inputs, false);
     test_qap<typename basic_curve_type::scalar_field_type>(extended_domain_size_special, num_inputs, false);
+    test_qap<typename basic_curve_type::scalar_field_type>(rounded_step_domain_size, num_inputs, false);
+}
+
+BOOST_AUTO_TEST_CASE(qap_optimized_r1cs_test_case) {
+    test_qap_with_optimized_r1cs<typename curves::mnt6<298>::scalar_field_type>();
 }
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
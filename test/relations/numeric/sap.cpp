@@ -89,6 +89,15 @@ void test_sap(const std::size_t sap_degree, const std::size_t num_inputs, const
 
     BOOST_CHECK(sap_inst_1.is_satisfied(sap_wit));
     BOOST_CHECK(sap_inst_2.is_satisfied(sap_wit));
+
+    /* a reused workspace yields the same witness as a fresh witness map */
+    typename reductions::r1cs_to_sap<FieldType>::workspace_type workspace(example.constraint_system);
+    for (std::size_t i = 0; i < 2; ++i) {
+        const sap_witness<FieldType> &reused_wit = reductions::r1cs_to_sap<FieldType>::witness_map(
+            example.constraint_system, example.primary_input, example.auxiliary_input, d1, d2, workspace);
+        BOOST_CHECK(reused_wit.coefficients_for_ACs == sap_wit.coefficients_for_ACs);
+        BOOST_CHECK(reused_wit.coefficients_for_H == sap_wit.coefficients_for_H);
+    }
 }
 
 BOOST_AUTO_TEST_SUITE(sap_test_suite)
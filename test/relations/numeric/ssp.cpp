@@ -79,6 +79,15 @@ void test_ssp(const std::size_t num_constraints, const std::size_t num_inputs, c
 
     BOOST_CHECK(ssp_inst_1.is_satisfied(ssp_wit));
     BOOST_CHECK(ssp_inst_2.is_satisfied(ssp_wit));
+
+    /* a reused workspace yields the same witness as a fresh witness map */
+    typename reductions::uscs_to_ssp<FieldType>::workspace_type workspace(example.constraint_system);
+    for (std::size_t i = 0; i < 2; ++i) {
+        const ssp_witness<FieldType> &reused_wit = reductions::uscs_to_ssp<FieldType>::witness_map(
+            example.constraint_system, example.primary_input, example.auxiliary_input, d, workspace);
+        BOOST_CHECK(reused_wit.coefficients_for_Vs == ssp_wit.coefficients_for_Vs);
+        BOOST_CHECK(reused_wit.coefficients_for_H == ssp_wit.coefficients_for_H);
+    }
 }
 
 BOOST_AUTO_TEST_SUITE(ssp_test_suite)
@@ -53,10 +53,67 @@ void test_bacs_ppzksnark(std::size_t primary_input_size, std::size_t auxiliary_i
     BOOST_CHECK(bit);
 }
 
+/* constant left-hand sides leave A lighter than B, so the generator swaps the two sides */
+template<typename CurveType>
+void test_bacs_ppzksnark_swapped_AB(std::size_t primary_input_size, std::size_t auxiliary_input_size,
+                                    std::size_t num_gates, std::size_t num_outputs) {
+    typedef typename CurveType::scalar_field_type field_type;
+    typedef bacs_ppzksnark<CurveType> scheme_type;
+
+    bacs_example<field_type> example =
+        generate_bacs_example<field_type>(primary_input_size, auxiliary_input_size, num_gates, num_outputs);
+    const bacs_variable_assignment<field_type> wires =
+        example.circuit.get_all_wires(example.primary_input, example.auxiliary_input);
+    for (auto &g : example.circuit.gates) {
+        g.lhs = linear_combination<field_type>(g.lhs.evaluate(wires));
+    }
+    BOOST_CHECK(example.circuit.is_satisfied(example.primary_input, example.auxiliary_input));
+    BOOST_CHECK(reductions::bacs_to_r1cs<field_type>::instance_map(example.circuit).is_swap_AB_beneficial());
+
+    typename scheme_type::keypair_type keypair = generate<scheme_type>(example.circuit);
+    BOOST_CHECK(reductions::bacs_to_r1cs<field_type>::is_swapped_AB(example.circuit,
+                                                                     keypair.first.r1cs_pk.constraint_system));
+
+    typename scheme_type::proof_type proof =
+        prove<scheme_type>(keypair.first, example.primary_input, example.auxiliary_input);
+    BOOST_CHECK(verify<scheme_type>(keypair.second, example.primary_input, proof));
+}
+
+template<typename FieldType>
+void test_bacs_levelized_circuit(std::size_t primary_input_size, std::size_t auxiliary_input_size,
+                                 std::size_t num_gates, std::size_t num_outputs) {
+    const bacs_example<FieldType> example =
+        generate_bacs_example<FieldType>(primary_input_size, auxiliary_input_size, num_gates, num_outputs);
+
+    bacs_variable_assignment<FieldType> expected;
+    expected.insert(expected.end(), example.primary_input.begin(), example.primary_input.end());
+    expected.insert(expected.end(), example.auxiliary_input.begin(), example.auxiliary_input.end());
+    for (auto &g : example.circuit.gates) {
+        expected.emplace_back(g.evaluate(expected));
+    }
+
+    const bacs_levelized_circuit<FieldType> levelized = example.circuit.levelized();
+    BOOST_CHECK_EQUAL(levelized.num_gates(), num_gates);
+    BOOST_CHECK_LE(levelized.num_levels(), num_gates);
+    BOOST_CHECK(levelized.get_all_wires(example.primary_input, example.auxiliary_input) == expected);
+    BOOST_CHECK(levelized.is_satisfied(example.primary_input, example.auxiliary_input));
+    BOOST_CHECK(example.circuit.get_all_wires(example.primary_input, example.auxiliary_input) == expected);
+    BOOST_CHECK(example.circuit.get_all_outputs(example.primary_input, example.auxiliary_input).size() ==
+                num_outputs);
+}
+
 BOOST_AUTO_TEST_SUITE(bacs_ppzksnark_test_suite)
 
+BOOST_AUTO_TEST_CASE(bacs_levelized_circuit_test) {
+    test_bacs_levelized_circuit<curves::mnt4<298>::scalar_field_type>(10, 10, 100, 5);
+}
+
 BOOST_AUTO_TEST_CASE(bacs_ppzksnark_test) {
     test_bacs_ppzksnark<curves::mnt4<298>>(10, 10, 20, 5);
 }
 
+BOOST_AUTO_TEST_CASE(bacs_ppzksnark_swapped_AB_test) {
+    test_bacs_ppzksnark_swapped_AB<curves::mnt4<298>>(10, 10, 20, 5);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
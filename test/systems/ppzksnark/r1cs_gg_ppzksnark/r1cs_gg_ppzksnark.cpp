@@ -44,12 +44,18 @@
 #include <nil/crypto3/algebra/pairing/mnt6.hpp>
 #include <nil/crypto3/algebra/algorithms/pair.hpp>
 
+#include <nil/crypto3/zk/snark/relations/constraint_satisfaction_problems/r1cs_optimizer.hpp>
+
 #include "../r1cs_examples.hpp"
 #include "run_r1cs_gg_ppzksnark.hpp"
 
 using namespace nil::crypto3::zk::snark;
 using namespace nil::crypto3::algebra;
 
+/* the basic test must exercise the affine verifier, not its no-op fallback */
+static_assert(has_affine_pairing<curves::mnt4<298>>::value,
+              "the mnt4<298> pairing no longer provides the affine ate Miller loop");
+
 template<typename CurveType>
 void run_r1cs_gg_ppzksnark_basic_test(std::size_t num_constraints, std::size_t input_size) {
     r1cs_example<typename CurveType::scalar_field_type> example =
@@ -58,10 +64,140 @@ void run_r1cs_gg_ppzksnark_basic_test(std::size_t num_constraints, std::size_t i
     BOOST_CHECK(bit);
 }
 
+template<typename CurveType>
+void run_r1cs_gg_ppzksnark_optimized_test(std::size_t num_constraints, std::size_t input_size) {
+    typedef typename CurveType::scalar_field_type field_type;
+    typedef r1cs_gg_ppzksnark<CurveType> scheme_type;
+
+    r1cs_example<field_type> example =
+        generate_r1cs_example_with_binary_input<field_type>(num_constraints, input_size);
+    const r1cs_optimized_constraint_system<field_type> optimized =
+        r1cs_optimizer<field_type>::process(example.constraint_system);
+    BOOST_CHECK(optimized.constraint_system.num_constraints() <= example.constraint_system.num_constraints());
+
+    typename scheme_type::keypair_type keypair = generate<scheme_type>(optimized);
+    typename scheme_type::proof_type proof =
+        prove<scheme_type>(keypair.first, optimized, example.primary_input, example.auxiliary_input);
+    BOOST_CHECK(verify<scheme_type>(keypair.second, example.primary_input, proof));
+}
+
+/*
+ * Public key of a toy verifiable encryption of the first delta_s_g1.size() primary inputs, built from the
+ * verification key so that its ciphertexts satisfy the equations checked by the encrypted-input verifier.
+ */
+template<typename CurveType>
+struct encrypted_input_test_public_key {
+    typedef typename CurveType::scalar_field_type scalar_field_type;
+    typedef typename CurveType::template g1_type<> g1_type;
+    typedef typename CurveType::template g2_type<> g2_type;
+
+    typename scalar_field_type::value_type s;
+    std::vector<typename scalar_field_type::value_type> s_i, t_i;
+
+    std::vector<typename g1_type::value_type> delta_s_g1, t_g1;
+    std::vector<typename g2_type::value_type> t_g2;
+    typename g1_type::value_type gamma_inverse_sum_s_g1;
+
+    template<typename VerificationKey>
+    encrypted_input_test_public_key(const VerificationKey &vk, std::size_t num_encrypted) :
+        s(random_element<scalar_field_type>()) {
+        for (std::size_t i = 0; i < num_encrypted + 1; ++i) {
+            t_i.emplace_back(random_element<scalar_field_type>());
+            t_g2.emplace_back(t_i.back() * g2_type::value_type::one());
+        }
+        for (std::size_t i = 0; i < num_encrypted; ++i) {
+            s_i.emplace_back(random_element<scalar_field_type>());
+            delta_s_g1.emplace_back(s_i.back() * vk.delta_g1);
+            t_g1.emplace_back(t_i[i] * g1_type::value_type::one());
+        }
+        /* the r * s * delta_g1 the ciphertexts add to the input accumulator is cancelled in g_C */
+        gamma_inverse_sum_s_g1 = -s * vk.gamma_g1;
+    }
+
+    template<typename VerificationKey>
+    std::vector<typename g1_type::value_type> encrypt(const VerificationKey &vk,
+                                                      const r1cs_primary_input<scalar_field_type> &primary_input,
+                                                      const typename scalar_field_type::value_type &r) const {
+        typename scalar_field_type::value_type s0 = s;
+        for (const auto &v : s_i) {
+            s0 = s0 - v;
+        }
+
+        std::vector<typename g1_type::value_type> ct;
+        ct.emplace_back((r * s0) * vk.delta_g1);
+        for (std::size_t i = 0; i < delta_s_g1.size(); ++i) {
+            ct.emplace_back(primary_input[i] * vk.gamma_ABC_g1.rest[i] + r * delta_s_g1[i]);
+        }
+        typename g1_type::value_type last = g1_type::value_type::zero();
+        for (std::size_t i = 0; i < ct.size(); ++i) {
+            last = last + t_i[i] * ct[i];
+        }
+        ct.emplace_back(last);
+        return ct;
+    }
+};
+
+template<typename CurveType>
+void run_r1cs_gg_ppzksnark_encrypted_input_batch_test(std::size_t num_constraints, std::size_t input_size,
+                                                      std::size_t num_encrypted, std::size_t num_proofs) {
+    typedef typename CurveType::scalar_field_type field_type;
+    typedef r1cs_gg_ppzksnark<CurveType, r1cs_gg_ppzksnark_generator<CurveType, ProvingMode::EncryptedInput>,
+                              r1cs_gg_ppzksnark_prover<CurveType, ProvingMode::EncryptedInput>,
+                              r1cs_gg_ppzksnark_verifier_strong_input_consistency<CurveType,
+                                                                                  ProvingMode::EncryptedInput>,
+                              ProvingMode::EncryptedInput>
+        scheme_type;
+    typedef r1cs_gg_ppzksnark_prover<CurveType, ProvingMode::EncryptedInput> prover_type;
+
+    std::vector<r1cs_primary_input<field_type>> primary_inputs;
+    std::vector<r1cs_auxiliary_input<field_type>> auxiliary_inputs;
+    std::vector<typename field_type::value_type> rs;
+    r1cs_example<field_type> example =
+        generate_r1cs_example_with_field_input<field_type>(num_constraints, input_size);
+    for (std::size_t i = 0; i < num_proofs; ++i) {
+        primary_inputs.emplace_back(example.primary_input);
+        auxiliary_inputs.emplace_back(example.auxiliary_input);
+        rs.emplace_back(random_element<field_type>());
+    }
+
+    typename scheme_type::keypair_type keypair = generate<scheme_type>(example.constraint_system);
+    const encrypted_input_test_public_key<CurveType> pubkey(keypair.second, num_encrypted);
+    const r1cs_primary_input<field_type> unencrypted_primary_input(example.primary_input.begin() + num_encrypted,
+                                                                   example.primary_input.end());
+
+    const std::vector<typename scheme_type::proof_type> proofs =
+        prover_type::process(keypair.first, pubkey, primary_inputs, auxiliary_inputs, rs);
+    BOOST_CHECK_EQUAL(proofs.size(), num_proofs);
+    for (std::size_t i = 0; i < num_proofs; ++i) {
+        const auto ct = pubkey.encrypt(keypair.second, primary_inputs[i], rs[i]);
+        const typename scheme_type::proof_type single_proof =
+            prove<scheme_type>(keypair.first, pubkey, primary_inputs[i], auxiliary_inputs[i], rs[i]);
+
+        BOOST_CHECK(scheme_type::verify(ct.begin(), ct.end(), keypair.second, pubkey, unencrypted_primary_input,
+                                        single_proof));
+        BOOST_CHECK(scheme_type::verify(ct.begin(), ct.end(), keypair.second, pubkey, unencrypted_primary_input,
+                                        proofs[i]));
+
+        /* the proof is bound to the randomness of its own encryption */
+        const auto other_ct =
+            pubkey.encrypt(keypair.second, primary_inputs[i], rs[i] + field_type::value_type::one());
+        BOOST_CHECK(!scheme_type::verify(other_ct.begin(), other_ct.end(), keypair.second, pubkey,
+                                         unencrypted_primary_input, proofs[i]));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE(r1cs_gg_ppzksnark_test_suite)
 
 BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_basic_test) {
     run_r1cs_gg_ppzksnark_basic_test<curves::mnt4<298>>(1000, 100);
 }
 
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_encrypted_input_batch_test) {
+    run_r1cs_gg_ppzksnark_encrypted_input_batch_test<curves::mnt4<298>>(100, 10, 4, 3);
+}
+
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_optimized_test) {
+    run_r1cs_gg_ppzksnark_optimized_test<curves::mnt4<298>>(100, 10);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+//---------------------------------------------------------------------------//
+// Copyright (c) 2021 Mikhail Komarov <nemo@nil.foundation>
+//
+// MIT License
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------//
+// @file Test program that counts the heap allocations of the Groth16 verifier input accumulation.
+//
+// The global allocation functions are replaced by counting ones, so this test lives in its own translation unit.
+//---------------------------------------------------------------------------//
+
+#define BOOST_TEST_MODULE r1cs_gg_ppzksnark_allocations_test
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <nil/crypto3/algebra/curves/mnt4.hpp>
+#include <nil/crypto3/algebra/fields/mnt4/base_field.hpp>
+#include <nil/crypto3/algebra/fields/mnt4/scalar_field.hpp>
+#include <nil/crypto3/algebra/fields/arithmetic_params/mnt4.hpp>
+#include <nil/crypto3/algebra/curves/params/multiexp/mnt4.hpp>
+#include <nil/crypto3/algebra/curves/params/wnaf/mnt4.hpp>
+#include <nil/crypto3/algebra/pairing/mnt4.hpp>
+#include <nil/crypto3/algebra/algorithms/pair.hpp>
+
+#include <nil/crypto3/zk/snark/systems/ppzksnark/r1cs_gg_ppzksnark.hpp>
+
+#include <nil/crypto3/zk/snark/algorithms/generate.hpp>
+#include <nil/crypto3/zk/snark/algorithms/prove.hpp>
+#include <nil/crypto3/zk/snark/algorithms/verify.hpp>
+
+#include "../r1cs_examples.hpp"
+
+using namespace nil::crypto3::zk::snark;
+using namespace nil::crypto3::algebra;
+
+namespace {
+    /* atomic, as the multi-exponentiations and the pairing library may allocate from several threads */
+    std::atomic<std::size_t> allocation_count(0);
+
+    void *counted_allocate(std::size_t size) noexcept {
+        ++allocation_count;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    /* std::aligned_alloc wants a size that is a multiple of the alignment */
+    void *counted_allocate(std::size_t size, std::align_val_t alignment) noexcept {
+        ++allocation_count;
+        const std::size_t align = static_cast<std::size_t>(alignment);
+        return std::aligned_alloc(align, size == 0 ? align : (size + align - 1) / align * align);
+    }
+
+    template<typename... Alignment>
+    void *throwing_allocate(std::size_t size, Alignment... alignment) {
+        if (void *p = counted_allocate(size, alignment...)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}    // namespace
+
+/* every replaceable allocation function is counted; all of them allocate with malloc or aligned_alloc */
+void *operator new(std::size_t size) {
+    return throwing_allocate(size);
+}
+
+void *operator new[](std::size_t size) {
+    return throwing_allocate(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return counted_allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return counted_allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+    return throwing_allocate(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+    return throwing_allocate(size, alignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return counted_allocate(size, alignment);
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return counted_allocate(size, alignment);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept {
+    std::free(p);
+}
+
+template<typename CurveType>
+void run_r1cs_gg_ppzksnark_allocations_test(std::size_t num_constraints, std::size_t input_size) {
+    typedef typename CurveType::scalar_field_type field_type;
+    typedef typename CurveType::template g1_type<>::value_type g1_value_type;
+    typedef r1cs_gg_ppzksnark<CurveType> scheme_type;
+    typedef r1cs_gg_ppzksnark_verifier_weak_input_consistency<CurveType> verifier_type;
+
+    r1cs_example<field_type> example = generate_r1cs_example_with_field_input<field_type>(num_constraints, input_size);
+    typename scheme_type::keypair_type keypair = generate<scheme_type>(example.constraint_system);
+    typename scheme_type::proof_type proof =
+        prove<scheme_type>(keypair.first, example.primary_input, example.auxiliary_input);
+
+    const typename scheme_type::processed_verification_key_type pvk =
+        r1cs_gg_ppzksnark_process_verification_key<CurveType>::process(keypair.second, 16);
+    BOOST_CHECK(!pvk.gamma_ABC_g1_precomp.empty());
+
+    const auto input_begin = example.primary_input.begin(), input_end = example.primary_input.end();
+    const g1_value_type expected = pvk.gamma_ABC_g1.accumulate_chunk(input_begin, input_end, 0).first;
+
+    /* window tables of a key processed for many verifications */
+    std::size_t before = allocation_count;
+    const g1_value_type acc = verifier_type::accumulate_input(pvk, example.primary_input);
+    BOOST_CHECK(allocation_count == before);
+    BOOST_CHECK(acc == expected);
+
+    /* plain scalar multiplications on a key processed once */
+    before = allocation_count;
+    const g1_value_type acc_in_place = pvk.gamma_ABC_g1.accumulate_in_place(input_begin, input_end);
+    BOOST_CHECK(allocation_count == before);
+    BOOST_CHECK(acc_in_place == expected);
+
+    /*
+     * The pairing checks still allocate: precompute_g2() of the pairing library returns the Miller loop
+     * coefficients of proof.g_B in vectors. Report the count rather than assert on it.
+     */
+    before = allocation_count;
+    BOOST_CHECK(verify<scheme_type>(pvk, example.primary_input, proof));
+    BOOST_TEST_MESSAGE("allocations per verification: " << allocation_count - before);
+}
+
+BOOST_AUTO_TEST_SUITE(r1cs_gg_ppzksnark_allocations_test_suite)
+
+BOOST_AUTO_TEST_CASE(r1cs_gg_ppzksnark_allocations_test) {
+    run_r1cs_gg_ppzksnark_allocations_test<curves::mnt4<298>>(100, 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -49,19 +49,34 @@ namespace nil {
                  * R1CS example (specified by a constraint system, input, and witness).
                  */
 
-                // template<typename CurveType>
-                // typename std::enable_if<CurveType::has_affine_pairing, void>::type
-                //     test_affine_verifier(const typename r1cs_gg_ppzksnark<CurveType>::verification_key_type &vk,
-                //                          const typename r1cs_gg_ppzksnark<CurveType>::primary_input_type
-                //                          &primary_input, const typename r1cs_gg_ppzksnark<CurveType>::proof_type
-                //                          &proof, const bool expected_answer) {
-                //     const bool answer = verify<r1cs_gg_ppzksnark<
-                //         CurveType,
-                //         r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency<CurveType>>>(vk,
-                //                                                                               primary_input,
-                //                                                                               proof);
-                //     BOOST_CHECK(answer == expected_answer);
-                // }
+                template<typename CurveType>
+                typename std::enable_if<has_affine_pairing<CurveType>::value, void>::type
+                    test_affine_verifier(const typename r1cs_gg_ppzksnark<CurveType>::verification_key_type &vk,
+                                         const typename r1cs_gg_ppzksnark<CurveType>::primary_input_type &primary_input,
+                                         const typename r1cs_gg_ppzksnark<CurveType>::proof_type &proof,
+                                         const bool expected_answer) {
+                    using affine_proof_system =
+                        r1cs_gg_ppzksnark<CurveType, r1cs_gg_ppzksnark_generator<CurveType>,
+                                          r1cs_gg_ppzksnark_prover<CurveType>,
+                                          r1cs_gg_ppzksnark_affine_verifier_weak_input_consistency<CurveType>>;
+
+                    std::cout << "Starting affine verifier" << std::endl;
+
+                    const bool answer = verify<affine_proof_system>(vk, primary_input, proof);
+
+                    std::cout << "Affine verifier finished, result: " << answer << std::endl;
+
+                    BOOST_CHECK(answer == expected_answer);
+                }
+
+                template<typename CurveType>
+                typename std::enable_if<!has_affine_pairing<CurveType>::value, void>::type
+                    test_affine_verifier(const typename r1cs_gg_ppzksnark<CurveType>::verification_key_type &,
+                                         const typename r1cs_gg_ppzksnark<CurveType>::primary_input_type &,
+                                         const typename r1cs_gg_ppzksnark<CurveType>::proof_type &,
+                                         const bool) {
+                    BOOST_TEST_MESSAGE("Affine verifier skipped: the pairing has no affine coordinates");
+                }
 
                 /**
                  * The code below provides an example of all stages of running a R1CS GG-ppzkSNARK.
@@ -133,7 +148,32 @@ namespace nil {
 
                     BOOST_CHECK(ans == ans4);
 
-                    /*test_affine_verifier<CurveType>(keypair.vk, example.primary_input, proof, ans);*/
+                    std::cout << "Starting online verifier with precomputed gamma_ABC_g1" << std::endl;
+
+                    typename basic_proof_system::processed_verification_key_type pvk_precomp =
+                        r1cs_gg_ppzksnark_process_verification_key<CurveType>::process(keypair.second, 16);
+
+                    const bool ans5 = verify<basic_proof_system>(pvk_precomp, example.primary_input, proof);
+
+                    std::cout << "Online verifier with precomputed gamma_ABC_g1 finished, result: " << ans5
+                              << std::endl;
+
+                    BOOST_CHECK(ans == ans5);
+
+                    const auto input_begin = example.primary_input.begin(), input_end = example.primary_input.end();
+                    const typename CurveType::template g1_type<>::value_type acc =
+                        pvk.gamma_ABC_g1.accumulate_chunk(input_begin, input_end, 0).first;
+                    BOOST_CHECK(pvk.gamma_ABC_g1.accumulate(input_begin, input_end) == acc);
+                    BOOST_CHECK(pvk_precomp.gamma_ABC_g1_precomp.accumulate(input_begin, input_end) == acc);
+
+                    /* no window fits in a zero memory bound: the key is processed without tables */
+                    typename basic_proof_system::processed_verification_key_type pvk_unbuilt =
+                        r1cs_gg_ppzksnark_process_verification_key<CurveType>::process(keypair.second, 16, 0);
+                    BOOST_CHECK(pvk_unbuilt.gamma_ABC_g1_precomp.empty());
+                    BOOST_CHECK(pvk_unbuilt == pvk_precomp);
+                    BOOST_CHECK(ans == verify<basic_proof_system>(pvk_unbuilt, example.primary_input, proof));
+
+                    test_affine_verifier<CurveType>(keypair.second, example.primary_input, proof, ans);
 
                     return ans;
                 }
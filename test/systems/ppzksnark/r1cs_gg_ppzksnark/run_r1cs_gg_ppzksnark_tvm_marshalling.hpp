@@ -29,6 +29,7 @@
 #ifndef CRYPTO3_RUN_R1CS_GG_PPZKSNARK_TVM_MARSHALLING_HPP
 #define CRYPTO3_RUN_R1CS_GG_PPZKSNARK_TVM_MARSHALLING_HPP
 
+#include <limits>
 #include <tuple>
 
 #include <nil/crypto3/zk/snark/schemes/ppzksnark/r1cs_gg_ppzksnark.hpp>
@@ -151,6 +152,10 @@ namespace nil {
                     std::vector<std::uint8_t> proving_key_byteblob = nil::marshalling::verifier_input_serializer_tvm<scheme_type>::process(
                         keypair.first);
 
+                    BOOST_CHECK(proving_key_byteblob.size() ==
+                                nil::marshalling::verifier_input_serializer_tvm<scheme_type>::proving_key_byteblob_size(
+                                    keypair.first));
+
                     marshalling::status_type provingProcessingStatus = marshalling::status_type::success;
 
                     typename scheme_type::proving_key_type other = 
@@ -168,17 +173,120 @@ namespace nil {
                     BOOST_CHECK(keypair.first.delta_g2 == other.delta_g2 && keypair.first.A_query == other.A_query);
                     BOOST_CHECK(keypair.first.B_query == other.B_query && keypair.first.H_query == other.H_query);
                     BOOST_CHECK(keypair.first.L_query == other.L_query);
-                    BOOST_CHECK(keypair.first.constraint_system == other.constraint_system);
-                    BOOST_CHECK(keypair.first.constraint_system.primary_input_size == other.constraint_system.primary_input_size);
-                    BOOST_CHECK(keypair.first.constraint_system.auxiliary_input_size == other.constraint_system.auxiliary_input_size);
-                    BOOST_CHECK(keypair.first.constraint_system.constraints.size() == other.constraint_system.constraints.size());
+                    BOOST_CHECK(*keypair.first.constraint_system == *other.constraint_system);
+                    BOOST_CHECK(keypair.first.constraint_system->primary_input_size == other.constraint_system->primary_input_size);
+                    BOOST_CHECK(keypair.first.constraint_system->auxiliary_input_size == other.constraint_system->auxiliary_input_size);
+                    BOOST_CHECK(keypair.first.constraint_system->constraints.size() == other.constraint_system->constraints.size());
 
-                    for (std::size_t i = 0; i < keypair.first.constraint_system.constraints.size(); i++){
+                    for (std::size_t i = 0; i < keypair.first.constraint_system->constraints.size(); i++){
                         std::cout << std::endl << "i:" << i << std::endl;
-                        // print_r1cs_constraint(keypair.first.constraint_system.constraints[i]);
-                        // print_r1cs_constraint(other.constraint_system.constraints[i]);
-                        BOOST_CHECK(keypair.first.constraint_system.constraints[i] == other.constraint_system.constraints[i]);
+                        // print_r1cs_constraint(keypair.first.constraint_system->constraints[i]);
+                        // print_r1cs_constraint(other.constraint_system->constraints[i]);
+                        BOOST_CHECK(keypair.first.constraint_system->constraints[i] == other.constraint_system->constraints[i]);
+                    }
+
+                    nil::marshalling::proving_key_stream_deserializer_tvm<scheme_type> stream_deserializer;
+
+                    // Feed the key in chunks which do not line up with record boundaries
+                    const std::size_t stream_chunk_size = 97;
+                    for (auto it = proving_key_byteblob.cbegin(); it < proving_key_byteblob.cend() &&
+                                                                  !stream_deserializer.is_complete();
+                         it += std::min<std::ptrdiff_t>(stream_chunk_size, proving_key_byteblob.cend() - it)) {
+                        BOOST_CHECK(stream_deserializer.process(
+                                        it, it + std::min<std::ptrdiff_t>(stream_chunk_size,
+                                                                          proving_key_byteblob.cend() - it)) ==
+                                    marshalling::status_type::success);
+                    }
+
+                    BOOST_CHECK(stream_deserializer.is_complete());
+                    BOOST_CHECK(keypair.first == stream_deserializer.result());
+
+                    // The whole key in one chunk goes through the same bounded slices
+                    nil::marshalling::proving_key_stream_deserializer_tvm<scheme_type> whole_stream_deserializer;
+                    BOOST_CHECK(whole_stream_deserializer.process(proving_key_byteblob.cbegin(),
+                                                                  proving_key_byteblob.cend()) ==
+                                marshalling::status_type::success);
+                    BOOST_CHECK(whole_stream_deserializer.is_complete());
+                    BOOST_CHECK(keypair.first == whole_stream_deserializer.result());
+
+                    // A malformed record is latched: the rest of the key is not consumed and never reported
+                    // as a success. The x coordinate of alpha_g1 is corrupted until it leaves the curve.
+                    bool corrupted_stream_rejected = false;
+                    for (std::uint8_t flip = 1; flip < 64 && !corrupted_stream_rejected; ++flip) {
+                        std::vector<std::uint8_t> corrupted_byteblob = proving_key_byteblob;
+                        corrupted_byteblob[nil::marshalling::verifier_input_deserializer_tvm<
+                            scheme_type>::g1_byteblob_size - 1] ^= flip;
+
+                        nil::marshalling::proving_key_stream_deserializer_tvm<scheme_type> corrupted_deserializer;
+                        marshalling::status_type corruptedStatus = corrupted_deserializer.process(
+                            corrupted_byteblob.cbegin(), corrupted_byteblob.cbegin() + stream_chunk_size);
+                        if (corruptedStatus == marshalling::status_type::invalid_msg_data) {
+                            corrupted_stream_rejected = true;
+                            BOOST_CHECK(corrupted_deserializer.process(corrupted_byteblob.cbegin() + stream_chunk_size,
+                                                                       corrupted_byteblob.cend()) ==
+                                        marshalling::status_type::invalid_msg_data);
+                            BOOST_CHECK(!corrupted_deserializer.is_complete());
+                        }
                     }
+                    BOOST_CHECK(corrupted_stream_rejected);
+
+                    std::vector<std::uint8_t> container_byteblob =
+                        nil::marshalling::key_container_serializer_tvm<scheme_type>::process(keypair.first,
+                                                                                             keypair.second);
+
+                    marshalling::status_type containerProcessingStatus = marshalling::status_type::success;
+
+                    typename scheme_type::verification_key_type container_vk =
+                        nil::marshalling::key_container_deserializer_tvm<scheme_type>::verification_key_process(
+                            container_byteblob.cbegin(), container_byteblob.cend(), containerProcessingStatus);
+
+                    BOOST_CHECK(containerProcessingStatus == marshalling::status_type::success);
+                    BOOST_CHECK(keypair.second == container_vk);
+
+                    typename scheme_type::proving_key_type container_pk =
+                        nil::marshalling::key_container_deserializer_tvm<scheme_type>::proving_key_process(
+                            container_byteblob.cbegin(), container_byteblob.cend(), containerProcessingStatus);
+
+                    BOOST_CHECK(containerProcessingStatus == marshalling::status_type::success);
+                    BOOST_CHECK(keypair.first == container_pk);
+
+                    // A corrupted query section must be rejected by its checksum
+                    const std::vector<nil::marshalling::key_container_section_entry> container_entries =
+                        nil::marshalling::key_container_deserializer_tvm<scheme_type>::header_process(
+                            container_byteblob.cbegin(), container_byteblob.cend(), containerProcessingStatus);
+                    BOOST_CHECK(containerProcessingStatus == marshalling::status_type::success);
+
+                    const auto H_query_entry = nil::marshalling::key_container_deserializer_tvm<scheme_type>::find_section(
+                        container_entries, nil::marshalling::key_container_section::H_query);
+                    BOOST_CHECK(H_query_entry != container_entries.end() && H_query_entry->size > 0);
+
+                    container_byteblob[H_query_entry->offset + H_query_entry->size / 2] ^= 0x01;
+                    nil::marshalling::key_container_deserializer_tvm<scheme_type>::proving_key_process(
+                        container_byteblob.cbegin(), container_byteblob.cend(), containerProcessingStatus);
+                    BOOST_CHECK(containerProcessingStatus == marshalling::status_type::invalid_msg_data);
+
+                    // The constraint system is stored once and shared by keys loaded from detached containers
+                    std::vector<std::uint8_t> constraint_system_byteblob =
+                        nil::marshalling::key_container_serializer_tvm<scheme_type>::process(
+                            *keypair.first.constraint_system);
+                    std::vector<std::uint8_t> detached_byteblob =
+                        nil::marshalling::key_container_serializer_tvm<scheme_type>::detached_process(keypair.first,
+                                                                                                       keypair.second);
+
+                    auto shared_constraint_system =
+                        nil::marshalling::key_container_deserializer_tvm<scheme_type>::constraint_system_process(
+                            constraint_system_byteblob.cbegin(), constraint_system_byteblob.cend(),
+                            containerProcessingStatus);
+                    BOOST_CHECK(containerProcessingStatus == marshalling::status_type::success);
+
+                    typename scheme_type::proving_key_type detached_pk =
+                        nil::marshalling::key_container_deserializer_tvm<scheme_type>::proving_key_process(
+                            detached_byteblob.cbegin(), detached_byteblob.cend(), shared_constraint_system,
+                            containerProcessingStatus);
+
+                    BOOST_CHECK(containerProcessingStatus == marshalling::status_type::success);
+                    BOOST_CHECK(keypair.first == detached_pk);
+                    BOOST_CHECK(detached_pk.constraint_system == shared_constraint_system);
 
                     std::vector<std::uint8_t> verification_key_byteblob = nil::marshalling::verifier_input_serializer_tvm<scheme_type>::process(
                         keypair.second);
@@ -260,6 +368,46 @@ namespace nil {
 
                     assert (de_prf == proof);
 
+                    // About half of all x coordinates are not on the curve, so some of these corruptions of
+                    // g_A must be reported instead of decoding to an invalid point
+                    bool corrupted_proof_rejected = false;
+                    for (std::uint8_t flip = 1; flip < 64 && !corrupted_proof_rejected; ++flip) {
+                        std::vector<std::uint8_t> corrupted_proof_byteblob = proof_byteblob;
+                        corrupted_proof_byteblob[nil::marshalling::verifier_input_deserializer_tvm<
+                            scheme_type>::g1_byteblob_size - 1] ^= flip;
+
+                        marshalling::status_type corruptedProcessingStatus = marshalling::status_type::success;
+                        nil::marshalling::verifier_input_deserializer_tvm<scheme_type>::proof_process(
+                            corrupted_proof_byteblob.cbegin(), corrupted_proof_byteblob.cend(),
+                            corruptedProcessingStatus);
+                        corrupted_proof_rejected = corruptedProcessingStatus == marshalling::status_type::invalid_msg_data;
+                    }
+                    BOOST_CHECK(corrupted_proof_rejected);
+
+                    // A huge length prefix must be reported, not wrap around in the size check and send the
+                    // decoder past the end of the buffer
+                    {
+                        using deserializer_type = nil::marshalling::verifier_input_deserializer_tvm<scheme_type>;
+
+                        std::vector<std::uint8_t> huge_primary_input_byteblob = primary_input_byteblob;
+                        std::fill(huge_primary_input_byteblob.begin(),
+                                  huge_primary_input_byteblob.begin() + deserializer_type::std_size_t_byteblob_size,
+                                  0xFF);
+                        marshalling::status_type hugeProcessingStatus = marshalling::status_type::success;
+                        deserializer_type::primary_input_process(huge_primary_input_byteblob.cbegin(),
+                                                                 huge_primary_input_byteblob.cend(),
+                                                                 hugeProcessingStatus);
+                        BOOST_CHECK(hugeProcessingStatus == marshalling::status_type::not_enough_data);
+
+                        // count * g1_byteblob_size wraps around to a small value
+                        const std::size_t wrapping_count =
+                            std::numeric_limits<std::size_t>::max() / deserializer_type::g1_byteblob_size + 1;
+                        hugeProcessingStatus = marshalling::status_type::success;
+                        deserializer_type::template g1_group_type_batch_process<typename CurveType::template g1_type<>>(
+                            proof_byteblob.cbegin(), proof_byteblob.cend(), wrapping_count, hugeProcessingStatus);
+                        BOOST_CHECK(hugeProcessingStatus == marshalling::status_type::not_enough_data);
+                    }
+
                     std::cout << std::hex << "Decoded primary input: " << std::endl;
 
                     for (auto it = de_pi.begin(); it != de_pi.end(); it++){
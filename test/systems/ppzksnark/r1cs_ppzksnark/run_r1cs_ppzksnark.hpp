@@ -130,6 +130,21 @@ namespace nil {
 
                     BOOST_CHECK(ans == ans4);
 
+                    std::cout << "Starting prover with concurrent multiexps" << std::endl;
+
+                    typename r1cs_ppzksnark_prover<CurveType>::workspace_type workspace(
+                        keypair.first.constraint_system);
+                    const typename basic_proof_system::proof_type concurrent_proof =
+                        r1cs_ppzksnark_prover<CurveType>::process(keypair.first, example.primary_input,
+                                                                  example.auxiliary_input, workspace,
+                                                                  multiexp_schedule::concurrent);
+
+                    const bool ans5 = verify<basic_proof_system>(keypair.second, example.primary_input, concurrent_proof);
+
+                    std::cout << "Verifier finished, result: " << ans5 << std::endl;
+
+                    BOOST_CHECK(ans == ans5);
+
                     /*test_affine_verifier<CurveType>(keypair.second, example.primary_input, proof, ans);*/
 
                     return ans;
@@ -75,6 +75,17 @@ namespace nil {
 
                     BOOST_CHECK(ans == ans2);
 
+                    typename r1cs_se_ppzksnark_prover<CurveType>::workspace_type workspace(
+                        keypair.first.constraint_system);
+                    const typename basic_proof_system::proof_type concurrent_proof =
+                        r1cs_se_ppzksnark_prover<CurveType>::process(keypair.first, example.primary_input,
+                                                                     example.auxiliary_input, workspace,
+                                                                     multiexp_schedule::concurrent);
+
+                    const bool ans3 = verify<basic_proof_system>(keypair.second, example.primary_input, concurrent_proof);
+
+                    BOOST_CHECK(ans == ans3);
+
                     return ans;
                 }
             }    // namespace snark
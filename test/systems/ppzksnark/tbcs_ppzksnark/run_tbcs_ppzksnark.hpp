@@ -77,6 +77,17 @@ namespace nil {
                     bool ans2 = verify<basic_proof_system>(pvk, example.primary_input, proof);
                     BOOST_CHECK(ans == ans2);
 
+                    std::cout << "TBCS ppzkSNARK Batch Prover" << std::endl;
+                    const std::vector<typename basic_proof_system::proof_type> proofs =
+                        tbcs_ppzksnark_prover<CurveType>::process(
+                            keypair.first, std::vector<tbcs_primary_input>(3, example.primary_input),
+                            std::vector<tbcs_auxiliary_input>(3, example.auxiliary_input));
+                    BOOST_CHECK_EQUAL(proofs.size(), 3);
+                    for (const typename basic_proof_system::proof_type &batch_proof : proofs) {
+                        BOOST_CHECK(ans == verify<basic_proof_system>(keypair.second, example.primary_input,
+                                                                      batch_proof));
+                    }
+
                     return ans;
                 }
 
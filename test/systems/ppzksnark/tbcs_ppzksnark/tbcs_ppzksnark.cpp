@@ -59,8 +59,41 @@ void test_tbcs_ppzksnark(std::size_t primary_input_size, std::size_t auxiliary_i
     BOOST_CHECK(bit);
 }
 
+void test_tbcs_bit_sliced_evaluation(std::size_t primary_input_size, std::size_t auxiliary_input_size,
+                                     std::size_t num_gates, std::size_t num_outputs, std::size_t num_assignments) {
+    const tbcs_example example =
+        generate_tbcs_example(primary_input_size, auxiliary_input_size, num_gates, num_outputs);
+
+    /* the example's own input, followed by random ones, which are unlikely to satisfy the circuit */
+    std::vector<tbcs_primary_input> primary_inputs(1, example.primary_input);
+    std::vector<tbcs_auxiliary_input> auxiliary_inputs(1, example.auxiliary_input);
+    for (std::size_t i = 1; i < num_assignments; ++i) {
+        primary_inputs.emplace_back(primary_input_size);
+        auxiliary_inputs.emplace_back(auxiliary_input_size);
+        for (std::size_t j = 0; j < primary_input_size; ++j) {
+            primary_inputs.back()[j] = std::rand() % 2;
+        }
+        for (std::size_t j = 0; j < auxiliary_input_size; ++j) {
+            auxiliary_inputs.back()[j] = std::rand() % 2;
+        }
+    }
+
+    const std::vector<tbcs_variable_assignment> all_wires =
+        example.circuit.get_all_wires(primary_inputs, auxiliary_inputs);
+    const std::vector<bool> satisfied = example.circuit.is_satisfied(primary_inputs, auxiliary_inputs);
+    BOOST_CHECK(satisfied[0]);
+    for (std::size_t i = 0; i < num_assignments; ++i) {
+        BOOST_CHECK(all_wires[i] == example.circuit.get_all_wires(primary_inputs[i], auxiliary_inputs[i]));
+        BOOST_CHECK_EQUAL(satisfied[i], example.circuit.is_satisfied(primary_inputs[i], auxiliary_inputs[i]));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE(tbcs_ppzksnark_test_suite)
 
+BOOST_AUTO_TEST_CASE(tbcs_bit_sliced_evaluation_test) {
+    test_tbcs_bit_sliced_evaluation(10, 10, 100, 5, 150);
+}
+
 BOOST_AUTO_TEST_CASE(tbcs_ppzksnark_test) {
     test_tbcs_ppzksnark<curves::mnt4<298>>(10, 10, 20, 5);
 }